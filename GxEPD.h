@@ -16,15 +16,306 @@
 class GxEPD : public Adafruit_GFX
 {
   public:
-    GxEPD(int16_t w, int16_t h) : Adafruit_GFX(w, h) {};
+    GxEPD(int16_t w, int16_t h) : Adafruit_GFX(w, h), _update_done_callback(0) {};
     virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
     virtual void init(void) = 0;
     virtual void fillScreen(uint16_t color) = 0; // to buffer
     virtual void update(void) = 0;
     // to full screen, filled with white if size is less, no update needed
     virtual void drawBitmap(const uint8_t *bitmap, uint32_t size) = 0; // b/w or grey is class specific
-    // b/w bitmap to buffer, may be cropped, drawPixel() used, update needed
+    // b/w bitmap to buffer, may be cropped, update needed
     virtual void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) = 0;
+    // start update(), return without waiting for the refresh to complete, synchronous if class has no busy line
+    virtual void updateAsync(void) {update(); _updateDone();};
+    // poll for completion of updateAsync(), finishes it when refresh is done (also after a busy pin change interrupt)
+    virtual bool isBusy(void) {return false;};
+    // callback called when an updateAsync() has completed
+    void onUpdateDone(void (*callback)(void)) {_update_done_callback = callback;};
+    // refresh profiles of the classes with setRefreshProfile() : full update of best quality, full update with a shorter
+    // waveform at a higher frame rate, partial update of the changed rows with a short waveform or the partial window
+    enum RefreshProfile {FULL_QUALITY, FULL_FAST, PARTIAL};
+  protected:
+    void _updateDone(void) {if (_update_done_callback) _update_done_callback();};
+    // clip rectangle to width() and height() and rotate it to physical coordinates; false if empty
+    bool _rotateRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+    {
+      if (w < 0)
+      {
+        x += w + 1;
+        w = -w;
+      }
+      if (h < 0)
+      {
+        y += h + 1;
+        h = -h;
+      }
+      if (x < 0)
+      {
+        w += x;
+        x = 0;
+      }
+      if (y < 0)
+      {
+        h += y;
+        y = 0;
+      }
+      if (w > width() - x) w = width() - x;
+      if (h > height() - y) h = height() - y;
+      if ((w <= 0) || (h <= 0)) return false;
+      int16_t t;
+      switch (getRotation())
+      {
+        case 1:
+          t = x;
+          x = WIDTH - y - h;
+          y = t;
+          t = w;
+          w = h;
+          h = t;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          t = y;
+          y = HEIGHT - x - w;
+          x = t;
+          t = w;
+          w = h;
+          h = t;
+          break;
+      }
+      return true;
+    }
+    // brightness of a 565 color, sum of the 8 bit red, green and blue components, 0 (black) .. 765 (white)
+    static uint16_t _brightness(uint16_t color)
+    {
+      uint8_t r = (color >> 11) & 0x1F, g = (color >> 5) & 0x3F, b = color & 0x1F;
+      return ((r << 3) | (r >> 2)) + ((g << 2) | (g >> 4)) + ((b << 3) | (b >> 2));
+    }
+    // set or clear the bits x .. x + w - 1 of a 1 bpp row, MSB first; true if any bit changed
+    static bool _fillBits(uint8_t* row, uint16_t x, uint16_t w, bool set)
+    {
+      bool changed = false;
+      uint16_t xe = x + w;
+      uint8_t* p = row + x / 8;
+      if (x % 8)
+      {
+        uint16_t be = (x | 7) + 1; // end of this byte
+        uint8_t mask = 0xFF >> (x % 8);
+        if (xe < be) mask &= 0xFF << (be - xe);
+        changed = _fillMask(p++, mask, set);
+        x = be;
+      }
+      if (x + 8 <= xe)
+      {
+        uint16_t n = (xe - x) / 8;
+        uint8_t value = set ? 0xFF : 0x00;
+        for (uint16_t i = 0; !changed && (i < n); i++) changed = (p[i] != value);
+        memset(p, value, n);
+        p += n;
+        x += 8 * n;
+      }
+      if (x < xe) changed |= _fillMask(p, 0xFF << (8 - (xe - x)), set);
+      return changed;
+    }
+    static bool _fillMask(uint8_t* p, uint8_t mask, bool set)
+    {
+      uint8_t data = set ? (*p | mask) : (*p & ~mask);
+      if (data == *p) return false;
+      *p = data;
+      return true;
+    }
+    // set the pixels x .. x + w - 1 of a 2 bpp row, MSB first, to grey level 0 (black) .. 3 (white)
+    // whole bytes are written with 32 bit stores where aligned
+    static void _fillBits2(uint8_t* row, uint16_t x, uint16_t w, uint8_t grey)
+    {
+      uint8_t value = grey * 0x55;
+      uint16_t xe = x + w;
+      uint8_t* p = row + x / 4;
+      uint8_t mask;
+      if (x % 4)
+      {
+        uint16_t be = (x | 3) + 1; // end of this byte
+        mask = 0xFF >> (2 * (x % 4));
+        if (xe < be) mask &= 0xFF << (2 * (be - xe));
+        *p = (*p & ~mask) | (value & mask);
+        p++;
+        x = be;
+      }
+      if (x >= xe) return;
+      uint8_t* pe = row + xe / 4; // end of whole bytes
+      while ((p < pe) && (uintptr_t(p) % 4)) *p++ = value;
+      uint32_t value32 = value * 0x01010101UL;
+      for (; p + 4 <= pe; p += 4) *(uint32_t*)p = value32;
+      while (p < pe) *p++ = value;
+      if (xe % 4)
+      {
+        mask = 0xFF << (2 * (4 - xe % 4));
+        *p = (*p & ~mask) | (value & mask);
+      }
+    }
+    // copy the bits x .. x + w - 1 from bits, aligned to the row, into a 1 bpp row; true if any bit changed
+    static bool _copyBits(uint8_t* row, uint16_t x, uint16_t w, const uint8_t* bits)
+    {
+      bool changed = false;
+      uint16_t xe = x + w;
+      uint8_t* p = row + x / 8;
+      uint8_t* pe = row + (xe - 1) / 8;
+      uint8_t mask = 0xFF >> (x % 8);
+      for (; p <= pe; p++, bits++)
+      {
+        if (p == pe) mask &= 0xFF << (7 - (xe - 1) % 8);
+        uint8_t data = (*p & ~mask) | (*bits & mask);
+        if (data != *p)
+        {
+          *p = data;
+          changed = true;
+        }
+        mask = 0xFF;
+      }
+      return changed;
+    }
+    // copy the pixels x .. x + w - 1 from bits, 1 bpp aligned to x % 4, into a 2 bpp row;
+    // bit set is white, bit clear is grey level grey
+    static void _copyBits2(uint8_t* row, uint16_t x, uint16_t w, const uint8_t* bits, uint8_t grey)
+    {
+      uint8_t expand[16]; // 4 pixels 1 bpp to 2 bpp
+      for (uint8_t n = 0; n < 16; n++)
+      {
+        expand[n] = 0;
+        for (uint8_t b = 0; b < 4; b++) expand[n] |= ((n & (0x08 >> b)) ? 3 : grey) << (6 - 2 * b);
+      }
+      uint16_t xe = x + w;
+      uint8_t* p = row + x / 4;
+      uint8_t* pe = row + (xe - 1) / 4;
+      uint8_t mask = 0xFF >> (2 * (x % 4));
+      for (uint8_t n = 0; p <= pe; p++, n++)
+      {
+        if (p == pe) mask &= 0xFF << (2 * (3 - (xe - 1) % 4));
+        uint8_t data = expand[(n & 1) ? bits[n / 2] & 0x0F : bits[n / 2] >> 4];
+        *p = (*p & ~mask) | (data & mask);
+        mask = 0xFF;
+      }
+    }
+    // mask of the pixels x .. x + w - 1 in byte i of a 2 bpp row, MSB first
+    static uint8_t _pixelMask2(uint16_t i, uint16_t x, uint16_t w)
+    {
+      uint8_t mask = 0xFF;
+      if (i == x / 4) mask >>= 2 * (x % 4);
+      if (i == (x + w - 1) / 4) mask &= 0xFF << (2 * (3 - (x + w - 1) % 4));
+      return mask;
+    }
+    // the pixels of a 1 bpp bitmap drawn at x, y with width w (rows padded to bytes), for physical row py,
+    // physical columns px .. px + pw - 1 (inside the bitmap), to bits, MSB first, starting at bit offset;
+    // bitmap is in PROGMEM on AVR if pgm is true, bits are inverted if invert is true
+    void _bitmapRow(uint8_t* bits, uint8_t offset, const uint8_t* bitmap, int16_t x, int16_t y, int16_t w,
+                    int16_t px, int16_t py, int16_t pw, bool pgm, bool invert)
+    {
+      uint8_t xor_mask = invert ? 0xFF : 0x00;
+      int16_t stride = (w + 7) / 8;
+      int16_t bx, by, dx = 0, dy = 0; // bitmap position of px and step per physical column
+      switch (getRotation())
+      {
+        case 0:
+          {
+            // shifted copy of a bitmap row, 8 pixels at a time
+            const uint8_t* src = bitmap + int32_t(py - y) * stride;
+            int16_t sb = px - x - offset; // bitmap bit of bits bit 0
+            for (int16_t n = 0; n < (offset + pw + 7) / 8; n++, sb += 8)
+            {
+              int16_t q = (sb < 0) ? -1 : sb / 8;
+              uint8_t r = sb - 8 * q;
+              uint16_t word = (uint16_t(_bitmapByte(src, q, stride, pgm)) << 8) | _bitmapByte(src, q + 1, stride, pgm);
+              bits[n] = (word >> (8 - r)) ^ xor_mask;
+            }
+          }
+          return;
+        case 1:
+          bx = py - x;
+          by = WIDTH - 1 - px - y;
+          dy = -1;
+          break;
+        case 2:
+          bx = WIDTH - 1 - px - x;
+          by = HEIGHT - 1 - py - y;
+          dx = -1;
+          break;
+        default:
+          bx = HEIGHT - 1 - py - x;
+          by = px - y;
+          dy = 1;
+          break;
+      }
+      // one pixel at a time, along a bitmap column or backwards along a bitmap row
+      const uint8_t* src = bitmap + int32_t(by) * stride + bx / 8;
+      uint8_t mask = 0x80 >> (bx % 8);
+      uint8_t* out = bits + offset / 8;
+      uint8_t out_mask = 0x80 >> (offset % 8);
+      uint8_t data = 0;
+      for (int16_t i = 0; i < pw; i++)
+      {
+        if (_bitmapByte(src, 0, 1, pgm) & mask) data |= out_mask;
+        if (dx)
+        {
+          mask <<= 1;
+          if (!mask)
+          {
+            mask = 0x01;
+            src--;
+          }
+        }
+        else src += dy * stride;
+        out_mask >>= 1;
+        if (!out_mask)
+        {
+          *out++ = data ^ xor_mask;
+          data = 0;
+          out_mask = 0x80;
+        }
+      }
+      if (out_mask != 0x80) *out = data ^ xor_mask;
+    }
+    // byte n of a bitmap row of size bytes, 0 outside
+    static uint8_t _bitmapByte(const uint8_t* row, int16_t n, int16_t size, bool pgm)
+    {
+      if ((n < 0) || (n >= size)) return 0;
+#if defined(__AVR)
+      if (pgm) return pgm_read_byte(row + n);
+#else
+      (void)pgm;
+#endif
+      return row[n];
+    }
+    // frames of a UC8151 class LUT : 7 phases of a level select byte, 4 frame counts and a repeat count
+    static uint32_t _lutFrames(const uint8_t* lut)
+    {
+      uint32_t frames = 0;
+      for (uint8_t i = 0; i < 7 * 6; i += 6)
+      {
+        frames += uint32_t(lut[i + 1] + lut[i + 2] + lut[i + 3] + lut[i + 4]) * lut[i + 5];
+      }
+      return frames;
+    }
+    // PLL setting (0x30) of UC8151 class controllers for a frame rate of 50, 100, 150 or 200 Hz
+    static uint8_t _pllSetting(uint16_t hz)
+    {
+      return (hz >= 200) ? 0x39 : (hz >= 150) ? 0x29 : (hz >= 100) ? 0x3a : 0x3c;
+    }
+    void (*_update_done_callback)(void);
+    // FNV-1a 32 bit hash, used to detect changed buffer rows
+    static uint32_t _hash32(const uint8_t* data, uint16_t n)
+    {
+      uint32_t hash = 2166136261UL;
+      while (n > 0)
+      {
+        hash ^= *data++;
+        hash *= 16777619UL;
+        n--;
+      }
+      return hash;
+    }
 };
 
 #endif
@@ -0,0 +1,57 @@
+// GxEPD_ExpandTable.h : byte of 1 bit per pixel to 4 bits per pixel, 256 entries
+//
+// used by the UC8159 class controller driver (GxGDEW075T8) to convert a buffer byte for upload,
+// bit set is black (0x0), bit clear is white (0x3); the pixels are in the 32 bit value MSB first,
+// to be sent most significant byte first.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_ExpandTable_H_
+#define _GxEPD_ExpandTable_H_
+
+#include <Arduino.h>
+
+#if defined(__AVR)
+#include <avr/pgmspace.h>
+#define GxEPD_expand4(b) pgm_read_dword(GxEPD_Expand4Table + (b))
+static const uint32_t GxEPD_Expand4Table[256] PROGMEM =
+#else
+#define GxEPD_expand4(b) (GxEPD_Expand4Table[(b)])
+static const uint32_t GxEPD_Expand4Table[256] =
+#endif
+{
+  0x33333333, 0x33333330, 0x33333303, 0x33333300, 0x33333033, 0x33333030, 0x33333003, 0x33333000,
+  0x33330333, 0x33330330, 0x33330303, 0x33330300, 0x33330033, 0x33330030, 0x33330003, 0x33330000,
+  0x33303333, 0x33303330, 0x33303303, 0x33303300, 0x33303033, 0x33303030, 0x33303003, 0x33303000,
+  0x33300333, 0x33300330, 0x33300303, 0x33300300, 0x33300033, 0x33300030, 0x33300003, 0x33300000,
+  0x33033333, 0x33033330, 0x33033303, 0x33033300, 0x33033033, 0x33033030, 0x33033003, 0x33033000,
+  0x33030333, 0x33030330, 0x33030303, 0x33030300, 0x33030033, 0x33030030, 0x33030003, 0x33030000,
+  0x33003333, 0x33003330, 0x33003303, 0x33003300, 0x33003033, 0x33003030, 0x33003003, 0x33003000,
+  0x33000333, 0x33000330, 0x33000303, 0x33000300, 0x33000033, 0x33000030, 0x33000003, 0x33000000,
+  0x30333333, 0x30333330, 0x30333303, 0x30333300, 0x30333033, 0x30333030, 0x30333003, 0x30333000,
+  0x30330333, 0x30330330, 0x30330303, 0x30330300, 0x30330033, 0x30330030, 0x30330003, 0x30330000,
+  0x30303333, 0x30303330, 0x30303303, 0x30303300, 0x30303033, 0x30303030, 0x30303003, 0x30303000,
+  0x30300333, 0x30300330, 0x30300303, 0x30300300, 0x30300033, 0x30300030, 0x30300003, 0x30300000,
+  0x30033333, 0x30033330, 0x30033303, 0x30033300, 0x30033033, 0x30033030, 0x30033003, 0x30033000,
+  0x30030333, 0x30030330, 0x30030303, 0x30030300, 0x30030033, 0x30030030, 0x30030003, 0x30030000,
+  0x30003333, 0x30003330, 0x30003303, 0x30003300, 0x30003033, 0x30003030, 0x30003003, 0x30003000,
+  0x30000333, 0x30000330, 0x30000303, 0x30000300, 0x30000033, 0x30000030, 0x30000003, 0x30000000,
+  0x03333333, 0x03333330, 0x03333303, 0x03333300, 0x03333033, 0x03333030, 0x03333003, 0x03333000,
+  0x03330333, 0x03330330, 0x03330303, 0x03330300, 0x03330033, 0x03330030, 0x03330003, 0x03330000,
+  0x03303333, 0x03303330, 0x03303303, 0x03303300, 0x03303033, 0x03303030, 0x03303003, 0x03303000,
+  0x03300333, 0x03300330, 0x03300303, 0x03300300, 0x03300033, 0x03300030, 0x03300003, 0x03300000,
+  0x03033333, 0x03033330, 0x03033303, 0x03033300, 0x03033033, 0x03033030, 0x03033003, 0x03033000,
+  0x03030333, 0x03030330, 0x03030303, 0x03030300, 0x03030033, 0x03030030, 0x03030003, 0x03030000,
+  0x03003333, 0x03003330, 0x03003303, 0x03003300, 0x03003033, 0x03003030, 0x03003003, 0x03003000,
+  0x03000333, 0x03000330, 0x03000303, 0x03000300, 0x03000033, 0x03000030, 0x03000003, 0x03000000,
+  0x00333333, 0x00333330, 0x00333303, 0x00333300, 0x00333033, 0x00333030, 0x00333003, 0x00333000,
+  0x00330333, 0x00330330, 0x00330303, 0x00330300, 0x00330033, 0x00330030, 0x00330003, 0x00330000,
+  0x00303333, 0x00303330, 0x00303303, 0x00303300, 0x00303033, 0x00303030, 0x00303003, 0x00303000,
+  0x00300333, 0x00300330, 0x00300303, 0x00300300, 0x00300033, 0x00300030, 0x00300003, 0x00300000,
+  0x00033333, 0x00033330, 0x00033303, 0x00033300, 0x00033033, 0x00033030, 0x00033003, 0x00033000,
+  0x00030333, 0x00030330, 0x00030303, 0x00030300, 0x00030033, 0x00030030, 0x00030003, 0x00030000,
+  0x00003333, 0x00003330, 0x00003303, 0x00003300, 0x00003033, 0x00003030, 0x00003003, 0x00003000,
+  0x00000333, 0x00000330, 0x00000303, 0x00000300, 0x00000033, 0x00000030, 0x00000003, 0x00000000
+};
+
+#endif
@@ -0,0 +1,319 @@
+// GxEPD_Waveform.h : container of temperature dependent waveform sets for the parallel interface display classes
+//
+// a waveform set gives the drive per frame for each grey level (0 black .. 3 white),
+// 0 no drive, 1 to black, 2 to white, for the begin phase (erase, grey level to white)
+// and for the end phase (draw, white to grey level), and the temperature range it is valid for.
+//
+// container format, bytes:
+//   'G', 'x', 'W', 'F', version (1), number of sets
+//   per set : min and max temperature in degree Celsius (int8_t, inclusive), begin frames, end frames (4 .. 255),
+//             begin drive of grey level 0 .. 3, then end drive of grey level 0 .. 3,
+//             each (frames + 3) / 4 bytes, 4 frames per byte, first frame in bits 7-6
+//
+// idle frames: the last begin frame and the first end frame must be of no drive for all grey levels,
+// the single pass transition from old to new grey level joins the phases there and leaves them out.
+// E-2 rule: of E end frames only the first E - 2 are output, the last 2 end frames must be of no drive.
+// load() rejects a set that drives any of these frames.
+//
+// the container can be in flash or RAM, or be read from a Stream (e.g. a File) into allocated RAM.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Waveform_H_
+#define _GxEPD_Waveform_H_
+
+#include <Arduino.h>
+
+#define GxEPD_Waveform_VERSION 1
+#define GxEPD_Waveform_HEADER_SIZE 6
+#define GxEPD_Waveform_SET_HEADER_SIZE 4
+#define GxEPD_Waveform_MIN_FRAMES 4
+
+class GxEPD_Waveforms
+{
+  public:
+    GxEPD_Waveforms() : _data(0), _size(0), _buffer(0) {};
+    ~GxEPD_Waveforms() {free(_buffer);};
+    // container in flash or RAM, not copied, must stay valid; false if not a valid container
+    bool load(const uint8_t* data, uint32_t size)
+    {
+      _data = 0;
+      _size = 0;
+      if (!_valid(data, size)) return false;
+      _data = data;
+      _size = size;
+      return true;
+    }
+    // container of size bytes read from stream; false if not a valid container or out of memory
+    bool load(Stream& stream, uint32_t size)
+    {
+      _data = 0;
+      _size = 0;
+      free(_buffer);
+      _buffer = (uint8_t*) malloc(size);
+      if (!_buffer) return false;
+      if (stream.readBytes((char*)_buffer, size) != size) return false;
+      return load(_buffer, size);
+    }
+    uint8_t sets()
+    {
+      return _data ? _data[5] : 0;
+    }
+    // index of the set for temperature, or of the set with the nearest range if none covers it; -1 if no sets
+    int16_t find(int8_t temperature)
+    {
+      int16_t best = -1;
+      int16_t best_distance = 0x7FFF;
+      for (uint8_t i = 0; i < sets(); i++)
+      {
+        int16_t distance = 0;
+        if (temperature < minTemperature(i)) distance = minTemperature(i) - temperature;
+        if (temperature > maxTemperature(i)) distance = temperature - maxTemperature(i);
+        if (distance < best_distance)
+        {
+          best = i;
+          best_distance = distance;
+        }
+      }
+      return best;
+    }
+    int8_t minTemperature(uint8_t set)
+    {
+      return int8_t(_set(set)[0]);
+    }
+    int8_t maxTemperature(uint8_t set)
+    {
+      return int8_t(_set(set)[1]);
+    }
+    uint8_t beginFrames(uint8_t set)
+    {
+      return _set(set)[2];
+    }
+    uint8_t endFrames(uint8_t set)
+    {
+      return _set(set)[3];
+    }
+    // drive of grey level in frame of the begin (erase) or end (draw) phase of set
+    uint8_t drive(uint8_t set, bool end, uint8_t level, uint16_t frame)
+    {
+      return _drive(_set(set), end, level, frame);
+    }
+    // for writing a container: its header for number of sets to out; returns bytes written
+    static uint32_t packHeader(uint8_t* out, uint8_t sets)
+    {
+      out[0] = 'G';
+      out[1] = 'x';
+      out[2] = 'W';
+      out[3] = 'F';
+      out[4] = GxEPD_Waveform_VERSION;
+      out[5] = sets;
+      return GxEPD_Waveform_HEADER_SIZE;
+    }
+    // for writing a container: a set from drive arrays [4][begin_frames] and [4][end_frames] to out; returns bytes written
+    static uint32_t packSet(uint8_t* out, int8_t min_temperature, int8_t max_temperature,
+                            const uint8_t* begin, uint8_t begin_frames, const uint8_t* end, uint8_t end_frames)
+    {
+      uint8_t* p = out;
+      *p++ = uint8_t(min_temperature);
+      *p++ = uint8_t(max_temperature);
+      *p++ = begin_frames;
+      *p++ = end_frames;
+      for (uint8_t phase = 0; phase < 2; phase++)
+      {
+        const uint8_t* drive = phase ? end : begin;
+        uint8_t frames = phase ? end_frames : begin_frames;
+        for (uint8_t level = 0; level < 4; level++)
+        {
+          memset(p, 0, _packed(frames));
+          for (uint16_t frame = 0; frame < frames; frame++)
+          {
+            p[frame / 4] |= (drive[level * frames + frame] & 0x3) << (6 - 2 * (frame % 4));
+          }
+          p += _packed(frames);
+        }
+      }
+      return p - out;
+    }
+    // container size for sets with these frame counts
+    static uint32_t setSize(uint8_t begin_frames, uint8_t end_frames)
+    {
+      return GxEPD_Waveform_SET_HEADER_SIZE + 4 * _packed(begin_frames) + 4 * _packed(end_frames);
+    }
+  private:
+    static uint16_t _packed(uint8_t frames)
+    {
+      return (frames + 3) / 4;
+    }
+    static uint8_t _drive(const uint8_t* p, bool end, uint8_t level, uint16_t frame)
+    {
+      uint8_t begin_frames = p[2];
+      uint8_t frames = end ? p[3] : begin_frames;
+      p += GxEPD_Waveform_SET_HEADER_SIZE + (end ? 4 * _packed(begin_frames) : 0) + level * _packed(frames);
+      return (p[frame / 4] >> (6 - 2 * (frame % 4))) & 0x3;
+    }
+    const uint8_t* _set(uint8_t set)
+    {
+      const uint8_t* p = _data + GxEPD_Waveform_HEADER_SIZE;
+      while (set-- > 0) p += setSize(p[2], p[3]);
+      return p;
+    }
+    static bool _valid(const uint8_t* data, uint32_t size)
+    {
+      if (!data || (size < GxEPD_Waveform_HEADER_SIZE)) return false;
+      if ((data[0] != 'G') || (data[1] != 'x') || (data[2] != 'W') || (data[3] != 'F')) return false;
+      if (data[4] != GxEPD_Waveform_VERSION) return false;
+      uint32_t index = GxEPD_Waveform_HEADER_SIZE;
+      for (uint8_t i = 0; i < data[5]; i++)
+      {
+        if (index + GxEPD_Waveform_SET_HEADER_SIZE > size) return false;
+        const uint8_t* p = data + index;
+        if (int8_t(p[0]) > int8_t(p[1])) return false;
+        if ((p[2] < GxEPD_Waveform_MIN_FRAMES) || (p[3] < GxEPD_Waveform_MIN_FRAMES)) return false;
+        uint32_t set_size = setSize(p[2], p[3]);
+        if (index + set_size > size) return false;
+        // each 2 bit drive is 0, 1 or 2
+        for (uint32_t j = GxEPD_Waveform_SET_HEADER_SIZE; j < set_size; j++)
+        {
+          for (uint8_t b = 0; b < 8; b += 2)
+          {
+            if (((p[j] >> b) & 0x3) == 0x3) return false;
+          }
+        }
+        // idle frames and the last 2 end frames, not output
+        for (uint8_t level = 0; level < 4; level++)
+        {
+          if (_drive(p, false, level, p[2] - 1) || _drive(p, true, level, 0)) return false;
+          if (_drive(p, true, level, p[3] - 2) || _drive(p, true, level, p[3] - 1)) return false;
+        }
+        index += set_size;
+      }
+      return true;
+    }
+  private:
+    const uint8_t* _data;
+    uint32_t _size;
+    uint8_t* _buffer;
+};
+
+// compile time expansion of a built-in waveform, constexpr drive arrays [4][frames], into frame major lookup tables,
+// to be placed in flash by the display classes instead of being built into RAM by init()
+
+template <uint16_t... I> struct GxEPD_Sequence {};
+
+// 0 .. N - 1, built by halves to keep the template depth logarithmic (N up to some 10000)
+template <class A, class B> struct GxEPD_Concat;
+template <uint16_t... A, uint16_t... B> struct GxEPD_Concat<GxEPD_Sequence<A...>, GxEPD_Sequence<B...> >
+{
+  typedef GxEPD_Sequence<A..., (sizeof...(A) + B)...> type;
+};
+template <uint16_t N> struct GxEPD_MakeSequence
+{
+  typedef typename GxEPD_Concat<typename GxEPD_MakeSequence<N / 2>::type, typename GxEPD_MakeSequence<N - N / 2>::type>::type type;
+};
+template <> struct GxEPD_MakeSequence<0>
+{
+  typedef GxEPD_Sequence<> type;
+};
+template <> struct GxEPD_MakeSequence<1>
+{
+  typedef GxEPD_Sequence<0> type;
+};
+
+// per frame: byte of 4 pixels grey level (first pixel in bits 7-6) to 4 pixels drive
+template <uint16_t FRAMES> struct GxEPD_WaveTable
+{
+  uint8_t table[FRAMES][256];
+};
+
+// per frame: 2 pixels old and new grey level (old, old, new, new) to 2 pixels drive,
+// and the transitions (old level * 4 + new level) driven in the frame;
+// single pass: begin frames without the idle last one, then end frames without the idle first one and the last 2
+template <uint16_t FRAMES> struct GxEPD_TransitionTable
+{
+  uint8_t table[FRAMES][256];
+  uint16_t frame_mask[FRAMES];
+};
+
+class GxEPD_WaveTables
+{
+  public:
+    // drive of the 4 pixels of num in frame; first pixel to lowest bits if reversed, else to bits 7-6
+    template <uint16_t FRAMES>
+    static constexpr uint8_t wave(const uint8_t (&drive)[4][FRAMES], bool reversed, uint16_t frame, uint8_t num)
+    {
+      return reversed ?
+             uint8_t((drive[num & 3][frame] << 6) | (drive[(num >> 2) & 3][frame] << 4) | (drive[(num >> 4) & 3][frame] << 2) | drive[num >> 6][frame]) :
+             uint8_t((drive[num >> 6][frame] << 6) | (drive[(num >> 4) & 3][frame] << 4) | (drive[(num >> 2) & 3][frame] << 2) | drive[num & 3][frame]);
+    }
+    template <uint16_t FRAMES, uint16_t... I>
+    static constexpr GxEPD_WaveTable<FRAMES> waveTable(const uint8_t (&drive)[4][FRAMES], bool reversed, GxEPD_Sequence<I...>)
+    {
+      return GxEPD_WaveTable<FRAMES> {{wave(drive, reversed, I / 256, I % 256)...}};
+    }
+    template <uint16_t FRAMES>
+    static constexpr GxEPD_WaveTable<FRAMES> waveTable(const uint8_t (&drive)[4][FRAMES], bool reversed)
+    {
+      return waveTable(drive, reversed, typename GxEPD_MakeSequence<FRAMES * 256>::type());
+    }
+    // drive of a pixel from old to new grey level in transition frame
+    template <uint16_t BEGIN, uint16_t END>
+    static constexpr uint8_t transition(const uint8_t (&begin)[4][BEGIN], const uint8_t (&end)[4][END],
+                                        uint8_t old_level, uint8_t new_level, uint16_t frame)
+    {
+      return (old_level == new_level) ? 0 : (frame < BEGIN - 1) ? begin[old_level][frame] : end[new_level][frame - (BEGIN - 1) + 1];
+    }
+    template <uint16_t BEGIN, uint16_t END>
+    static constexpr uint16_t frameMask(const uint8_t (&begin)[4][BEGIN], const uint8_t (&end)[4][END], uint16_t frame, uint8_t t = 0)
+    {
+      return (t == 16) ? 0 : (transition(begin, end, t >> 2, t & 3, frame) ? (1 << t) : 0) | frameMask(begin, end, frame, t + 1);
+    }
+    // drive of the 2 pixels of num in frame; first pixel to lowest bits if reversed, else to bits 3-2
+    template <uint16_t BEGIN, uint16_t END>
+    static constexpr uint8_t transition2(const uint8_t (&begin)[4][BEGIN], const uint8_t (&end)[4][END], bool reversed, uint16_t frame, uint8_t num)
+    {
+      return reversed ?
+             uint8_t(transition(begin, end, (num >> 6) & 3, (num >> 2) & 3, frame) | (transition(begin, end, (num >> 4) & 3, num & 3, frame) << 2)) :
+             uint8_t((transition(begin, end, (num >> 6) & 3, (num >> 2) & 3, frame) << 2) | transition(begin, end, (num >> 4) & 3, num & 3, frame));
+    }
+    template <uint16_t BEGIN, uint16_t END, uint16_t... I, uint16_t... F>
+    static constexpr GxEPD_TransitionTable<BEGIN - 1 + END - 3> transitionTable(const uint8_t (&begin)[4][BEGIN], const uint8_t (&end)[4][END],
+        bool reversed, GxEPD_Sequence<I...>, GxEPD_Sequence<F...>)
+    {
+      return GxEPD_TransitionTable<BEGIN - 1 + END - 3> {{transition2(begin, end, reversed, I / 256, I % 256)...}, {frameMask(begin, end, F)...}};
+    }
+    template <uint16_t BEGIN, uint16_t END>
+    static constexpr GxEPD_TransitionTable<BEGIN - 1 + END - 3> transitionTable(const uint8_t (&begin)[4][BEGIN], const uint8_t (&end)[4][END],
+        bool reversed)
+    {
+      return transitionTable(begin, end, reversed, typename GxEPD_MakeSequence<(BEGIN - 1 + END - 3) * 256>::type(),
+                             typename GxEPD_MakeSequence<BEGIN - 1 + END - 3>::type());
+    }
+    // fast black/white update, same drive in each frame: a changed pixel is driven from its old grey level
+    // to black or white, whichever is nearest to its new grey level, unless it is there already
+    static constexpr uint8_t fast(uint8_t old_level, uint8_t new_level)
+    {
+      return ((old_level == new_level) || (old_level == ((new_level & 2) ? 3 : 0))) ? 0 : (new_level & 2) ? 2 : 1;
+    }
+    static constexpr uint8_t fast2(bool reversed, uint8_t num)
+    {
+      return reversed ?
+             uint8_t(fast((num >> 6) & 3, (num >> 2) & 3) | (fast((num >> 4) & 3, num & 3) << 2)) :
+             uint8_t((fast((num >> 6) & 3, (num >> 2) & 3) << 2) | fast((num >> 4) & 3, num & 3));
+    }
+    static constexpr uint16_t fastMask(uint8_t t = 0)
+    {
+      return (t == 16) ? 0 : (fast(t >> 2, t & 3) ? (1 << t) : 0) | fastMask(t + 1);
+    }
+    template <uint16_t... I>
+    static constexpr GxEPD_TransitionTable<1> fastTable(bool reversed, GxEPD_Sequence<I...>)
+    {
+      return GxEPD_TransitionTable<1> {{fast2(reversed, I)...}, {fastMask()}};
+    }
+    // a transition table of one frame, in the layout of transitionTable()
+    static constexpr GxEPD_TransitionTable<1> fastTable(bool reversed)
+    {
+      return fastTable(reversed, GxEPD_MakeSequence<256>::type());
+    }
+};
+
+#endif
@@ -29,6 +29,7 @@
 */
 
 #include "GxGDE0213B1.h"
+#include "../GxEPD_MirrorTable.h"
 
 #define xPixelsPar (GxGDE0213B1_X_PIXELS-1)
 #define yPixelsPar (GxGDE0213B1_Y_PIXELS-1)
@@ -56,7 +57,9 @@ uint8_t RamDataEntryMode[] = {0x11, 0x01};  // Ram data entry mode
 
 GxGDE0213B1::GxGDE0213B1(GxIO& io, uint8_t rst, uint8_t busy) :
   GxEPD(GxGDE0213B1_WIDTH, GxGDE0213B1_HEIGHT),
-  IO(io), _rst(rst), _busy(busy)
+  IO(io), _rst(rst), _busy(busy),
+  _dirty_x0(GxGDE0213B1_WIDTH), _dirty_y0(GxGDE0213B1_HEIGHT), _dirty_x1(0), _dirty_y1(0),
+  _row_hashes_valid(false), _update_pending(false)
 {
 }
 
@@ -90,10 +93,16 @@ void GxGDE0213B1::drawPixel(int16_t x, int16_t y, uint16_t color)
   }
   uint16_t i = x / 8 + y * GxGDE0213B1_WIDTH / 8;
 
+  uint8_t data = _buffer[i];
   if (!color)
-    _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
+    data = (data | (1 << (7 - x % 8)));
   else
-    _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    data = (data & (0xFF ^ (1 << (7 - x % 8))));
+  if (data != _buffer[i])
+  {
+    _buffer[i] = data;
+    _markDirty(x, y, x, y);
+  }
 }
 
 void GxGDE0213B1::init(void)
@@ -109,70 +118,171 @@ void GxGDE0213B1::init(void)
 void GxGDE0213B1::fillScreen(uint16_t color)
 {
   uint8_t data = (color == GxEPD_BLACK) ? 0xFF : 0x00;
-  for (uint16_t x = 0; x < GxGDE0213B1_BUFFER_SIZE; x++)
+  for (uint16_t y = 0; y < sizeof(_buffer) / (GxGDE0213B1_WIDTH / 8); y++)
   {
-    _buffer[x] = data;
+    for (uint16_t x8 = 0; x8 < GxGDE0213B1_WIDTH / 8; x8++)
+    {
+      uint16_t idx = y * (GxGDE0213B1_WIDTH / 8) + x8;
+      if (_buffer[idx] != data)
+      {
+        _buffer[idx] = data;
+        _markDirty(x8 * 8, y, x8 * 8 + 7, y);
+      }
+    }
   }
 }
 
-void GxGDE0213B1::update(void)
+void GxGDE0213B1::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
 {
-  _wakeUp();
-  _writeCommand(0x24);
-  for (uint16_t y = 0; y < GxGDE0213B1_HEIGHT; y++)
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDE0213B1::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDE0213B1::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  for (int16_t y1 = y; y1 < y + h; y1++)
   {
-    for (uint16_t x = GxGDE0213B1_WIDTH / 8; x > 0; x--)
+    if (_fillBits(_buffer + uint16_t(y1) * (GxGDE0213B1_WIDTH / 8), x, w, !color))
     {
-      uint8_t data = _buffer[y * (GxGDE0213B1_WIDTH / 8) + x - 1];
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
+      _markDirty(x, y1, x + w - 1, y1);
     }
   }
-  // Update
-  _writeCommand(0x22);
-  _writeData(0xc7);
-  _writeCommand(0x20);
-  _writeCommand(0xff);
+}
+
+void GxGDE0213B1::update(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_startUpdate()) return;
+  _waitWhileBusy("update display refresh");
+  _PowerOff();
+}
+
+void GxGDE0213B1::updateAsync(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (_startUpdate()) _update_pending = true;
+  else _updateDone();
+}
+
+bool GxGDE0213B1::isBusy(void)
+{
+  if (!_update_pending) return false;
+  if (IO.readBusy(_busy)) return true; // =1 BUSY
+  _update_pending = false;
   _PowerOff();
+  _updateDone();
+  return false;
 }
 
 void GxGDE0213B1::drawBitmap(const uint8_t *bitmap, uint32_t size)
 {
-  _wakeUp();
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
+  _Init_Full();
   _writeCommand(0x24);
-  for (uint32_t i = 0; i < GxGDE0213B1_BUFFER_SIZE; i++)
-  {
-    _writeData((i < size) ? bitmap[i] : 0x00);
-  }
-  // Update
-  _writeCommand(0x22);
-  _writeData(0xc7);
-  _writeCommand(0x20);
-  _writeCommand(0xff);
+  _writeBitmap(bitmap, size, GxGDE0213B1_BUFFER_SIZE, 0x00);
+  _Update_Full();
   _PowerOff();
 }
 
 void  GxGDE0213B1::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  if (color)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  uint8_t bits[GxGDE0213B1_WIDTH / 8 + 1];
+  for (int16_t y1 = py; y1 < py + ph; y1++)
+  {
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, false, true); // bit set is black
+    if (_copyBits(_buffer + uint16_t(y1) * (GxGDE0213B1_WIDTH / 8), px, pw, bits))
     {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-      drawPixel(x1, y1, pixelcolor);
+      _markDirty(px, y1, px + pw - 1, y1);
     }
   }
 }
 
+void GxGDE0213B1::updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
+  if (x >= GxGDE0213B1_WIDTH) return;
+  if (y >= GxGDE0213B1_HEIGHT) return;
+  uint16_t xe = min(GxGDE0213B1_WIDTH, x + w) - 1;
+  uint16_t ye = min(GxGDE0213B1_HEIGHT, y + h) - 1;
+  uint16_t xs_bx = x / 8;
+  uint16_t xe_bx = xe / 8 + 1;
+  uint16_t p_xs = (GxGDE0213B1_WIDTH - xe - 1) / 8;
+  uint16_t p_xe = (GxGDE0213B1_WIDTH - x - 1) / 8;
+  uint16_t p_ys = (GxGDE0213B1_HEIGHT - y - 1);
+  uint16_t p_ye = (GxGDE0213B1_HEIGHT - ye - 1);
+  _Init_Part();
+  _SetRamArea(p_xs, p_xe, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
+  _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
+  _waitWhileBusy();
+  _writeCommand(0x24);
+  _writeBufferRows(y, ye, xs_bx, xe_bx);
+  _Update_Part();
+  delay(300);
+  // write again, to have both controller buffers in sync for the next partial update
+  _SetRamArea(p_xs, p_xe, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
+  _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
+  _waitWhileBusy();
+  _writeCommand(0x24);
+  _writeBufferRows(y, ye, xs_bx, xe_bx);
+  delay(300);
+  _PowerOff();
+}
+
+void GxGDE0213B1::updateDirty()
+{
+  if (_dirty_x0 > _dirty_x1) return; // nothing changed since last update
+  updateWindow(_dirty_x0, _dirty_y0, _dirty_x1 - _dirty_x0 + 1, _dirty_y1 - _dirty_y0 + 1);
+  _resetDirty();
+}
+
+bool GxGDE0213B1::_startUpdate(void)
+{
+#if defined(__AVR)
+  uint16_t ys = 0, ye = GxGDE0213B1_HEIGHT - 1;
+#else
+  uint16_t ys, ye;
+  if (!_changedRows(ys, ye))
+  {
+    _resetDirty();
+    return false; // panel shows the buffer content already
+  }
+#endif
+  uint16_t p_ys = (GxGDE0213B1_HEIGHT - ys - 1);
+  uint16_t p_ye = (GxGDE0213B1_HEIGHT - ye - 1);
+  _Init_Full();
+  // controller RAM keeps the unchanged rows, upload the changed rows only
+  _SetRamArea(0x00, xPixelsPar / 8, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
+  _SetRamPointer(0x00, p_ys % 256, p_ys / 256); // set ram
+  _writeCommand(0x24);
+  _writeBufferRows(ys, ye, 0, GxGDE0213B1_WIDTH / 8);
+  // _Update_Full() without waiting for the refresh
+  _writeCommand(0x22);
+  _writeData(0xc7);
+  _writeCommand(0x20);
+  _resetDirty();
+  return true;
+}
+
 void GxGDE0213B1::_writeCommand(uint8_t command)
 {
-  //while (digitalRead(_busy));
-  if (digitalRead(_busy))
+  //while (IO.readBusy(_busy));
+  if (IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(command, HEX);
     _waitWhileBusy(str.c_str());
@@ -185,10 +295,47 @@ void GxGDE0213B1::_writeData(uint8_t data)
   IO.writeDataTransaction(data);
 }
 
-void GxGDE0213B1::_writeCommandData(uint8_t *pCommandData, uint8_t datalen)
+void GxGDE0213B1::_writeData(const uint8_t* data, uint16_t n)
+{
+  IO.writeDataTransaction(data, n);
+}
+
+void GxGDE0213B1::_writeBufferRows(uint16_t ys, uint16_t ye, uint16_t xs_bx, uint16_t xe_bx)
+{
+  // one data block per row, x bytes in reverse order, bit order reversed and inverted
+  uint8_t row[GxGDE0213B1_WIDTH / 8];
+  for (uint16_t y1 = ys; y1 <= ye; y1++)
+  {
+    uint16_t n = 0;
+    for (uint16_t x1 = xe_bx; x1 > xs_bx; x1--)
+    {
+      uint8_t data = _buffer[y1 * (GxGDE0213B1_WIDTH / 8) + x1 - 1];
+      row[n++] = GxEPD_mirrorInvert(data);
+    }
+    _writeData(row, n);
+  }
+}
+
+void GxGDE0213B1::_writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill)
+{
+  // through a local block, filled with fill after size
+  uint8_t block[GxGDE0213B1_WIDTH / 8];
+  uint32_t i = 0;
+  while (i < count)
+  {
+    uint16_t n = 0;
+    for (; (n < sizeof(block)) && (i < count); n++, i++)
+    {
+      block[n] = (i < size) ? bitmap[i] : fill;
+    }
+    _writeData(block, n);
+  }
+}
+
+void GxGDE0213B1::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
 {
-  //while (digitalRead(_busy)); // wait
-  if (digitalRead(_busy))
+  //while (IO.readBusy(_busy)); // wait
+  if (IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(pCommandData[0], HEX);
     _waitWhileBusy(str.c_str());
@@ -205,21 +352,57 @@ void GxGDE0213B1::_writeCommandData(uint8_t *pCommandData, uint8_t datalen)
 
 void GxGDE0213B1::_waitWhileBusy(const char* comment)
 {
-  unsigned long start = micros();
+  //unsigned long start = micros();
   while (1)
   {
-    if (!digitalRead(_busy)) break;
+    if (!IO.readBusy(_busy)) break;
     delay(1);
   }
   if (comment)
   {
-    unsigned long elapsed = micros() - start;
+    //unsigned long elapsed = micros() - start;
     //Serial.print(comment);
     //Serial.print(" : ");
     //Serial.println(elapsed);
   }
 }
 
+void GxGDE0213B1::_markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+  if (x0 < _dirty_x0) _dirty_x0 = x0;
+  if (y0 < _dirty_y0) _dirty_y0 = y0;
+  if (x1 > _dirty_x1) _dirty_x1 = x1;
+  if (y1 > _dirty_y1) _dirty_y1 = y1;
+}
+
+void GxGDE0213B1::_resetDirty()
+{
+  _dirty_x0 = GxGDE0213B1_WIDTH;
+  _dirty_y0 = GxGDE0213B1_HEIGHT;
+  _dirty_x1 = 0;
+  _dirty_y1 = 0;
+}
+
+#if !defined(__AVR)
+bool GxGDE0213B1::_changedRows(uint16_t& ys, uint16_t& ye)
+{
+  ys = GxGDE0213B1_HEIGHT;
+  ye = 0;
+  for (uint16_t y = 0; y < GxGDE0213B1_HEIGHT; y++)
+  {
+    uint32_t hash = _hash32(_buffer + uint32_t(y) * (GxGDE0213B1_WIDTH / 8), GxGDE0213B1_WIDTH / 8);
+    if (!_row_hashes_valid || (hash != _row_hash[y]))
+    {
+      _row_hash[y] = hash;
+      if (y < ys) ys = y;
+      ye = y;
+    }
+  }
+  _row_hashes_valid = true;
+  return (ys <= ye);
+}
+#endif
+
 void GxGDE0213B1::_SetRamArea(uint8_t Xstart, uint8_t Xend,
                               uint8_t Ystart, uint8_t Ystart1,
                               uint8_t Yend, uint8_t Yend1)
@@ -243,11 +426,6 @@ void GxGDE0213B1::_SetRamPointer(uint8_t addrX, uint8_t addrY, uint8_t addrY1)
   _writeData(addrY1);
 }
 
-void GxGDE0213B1::_writeLUT(uint8_t *LUTvalue)
-{
-  _writeCommandData(LUTvalue, 31);
-}
-
 void GxGDE0213B1::_PowerOn(void)
 {
   _writeCommand(0x22);
@@ -262,7 +440,7 @@ void GxGDE0213B1::_PowerOff(void)
   _writeCommand(0x20);
 }
 
-void GxGDE0213B1::_wakeUp()
+void GxGDE0213B1::_InitDisplay(void)
 {
   _writeCommandData(GDOControl, sizeof(GDOControl));  // Pannel configuration, Gate selection
   _writeCommandData(softstart, sizeof(softstart));  // X decrease, Y decrease
@@ -272,7 +450,35 @@ void GxGDE0213B1::_wakeUp()
   _writeCommandData(RamDataEntryMode, sizeof(RamDataEntryMode));  // X decrease, Y decrease
   _SetRamArea(0x00, xPixelsPar/8, yPixelsPar%256, yPixelsPar/256, 0x00, 0x00);  // X-source area,Y-gate area
   _SetRamPointer(0x00, yPixelsPar%256, yPixelsPar/256); // set ram
-  _writeLUT((uint8_t *)LUTDefault_full);
+}
+
+void GxGDE0213B1::_Init_Full(void)
+{
+  _InitDisplay();
+  _writeCommandData(LUTDefault_full, sizeof(LUTDefault_full));
+  _PowerOn();
+}
+
+void GxGDE0213B1::_Init_Part(void)
+{
+  _InitDisplay();
+  _writeCommandData(LUTDefault_part, sizeof(LUTDefault_part));
   _PowerOn();
 }
 
+void GxGDE0213B1::_Update_Full(void)
+{
+  _writeCommand(0x22);
+  _writeData(0xc7);
+  _writeCommand(0x20);
+  _writeCommand(0xff);
+}
+
+void GxGDE0213B1::_Update_Part(void)
+{
+  _writeCommand(0x22);
+  _writeData(0x04);
+  _writeCommand(0x20);
+  _writeCommand(0xff);
+}
+
@@ -65,22 +65,45 @@ class GxGDE0213B1 : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // 0x0 black, >0x0 white, to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
+    // start update, return without waiting for refresh, isBusy() completes it
+    void updateAsync(void);
+    bool isBusy(void);
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t *bitmap, uint32_t size);
-    // to buffer, may be cropped, drawPixel() used, update needed
+    // to buffer, may be cropped, update needed
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+    // partial update of the window, in physical coordinates of the buffer, not rotated by setRotation();
+    // the updateWindow() of GxGDEW042T2, GxGDEW075T8 and the HD parallel display classes take rotated coordinates
+    void updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    // partial update of the area changed by drawPixel() or fillScreen() since the last update
+    void updateDirty();
   private:
     void _writeData(uint8_t data);
+    void _writeData(const uint8_t* data, uint16_t n);
+    void _writeBufferRows(uint16_t ys, uint16_t ye, uint16_t xs_bx, uint16_t xe_bx);
+    void _writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill);
     void _writeCommand(uint8_t command);
-    void _writeCommandData(uint8_t *pCommandData, uint8_t datalen);
+    void _writeCommandData(const uint8_t* pCommandData, uint8_t datalen);
     void _SetRamPointer(uint8_t addrX, uint8_t addrY, uint8_t addrY1);
     void _SetRamArea(uint8_t Xstart, uint8_t Xend, uint8_t Ystart, uint8_t Ystart1, uint8_t Yend, uint8_t Yend1);
-    void _writeLUT(uint8_t *LUTvalue);
     void _PowerOn(void);
     void _PowerOff(void);
-    void _wakeUp();
     void _waitWhileBusy(const char* comment=0);
+    void _InitDisplay(void);
+    void _Init_Full(void);
+    void _Init_Part(void);
+    void _Update_Full(void);
+    void _Update_Part(void);
+    void _markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    void _resetDirty();
+    bool _startUpdate(void); // false if nothing changed
+#if !defined(__AVR)
+    bool _changedRows(uint16_t& ys, uint16_t& ye); // since last update(), updates row hashes
+#endif
   protected:
     uint8_t _buffer[GxGDE0213B1_BUFFER_SIZE];
 
@@ -88,6 +111,12 @@ class GxGDE0213B1 : public GxEPD
     GxIO& IO;
     uint8_t _rst;
     uint8_t _busy;
+    uint16_t _dirty_x0, _dirty_y0, _dirty_x1, _dirty_y1; // bounding box of changes, physical
+    bool _row_hashes_valid; // _row_hash[] matches controller RAM
+    bool _update_pending; // updateAsync() refresh not yet completed
+#if !defined(__AVR)
+    uint32_t _row_hash[GxGDE0213B1_HEIGHT]; // of rows last sent by update()
+#endif
 };
 
 #endif
@@ -26,9 +26,15 @@
 
 #include "GxGDE06.h"
 
+// the built-in waveform, expanded at compile time, in flash
+static constexpr GxEPD_WaveTable<GxGDE06_FRAME_BEGIN_SIZE> wave_begin_table_06 = GxEPD_WaveTables::waveTable(wave_begin, true);
+static constexpr GxEPD_WaveTable<GxGDE06_FRAME_END_SIZE> wave_end_table_06 = GxEPD_WaveTables::waveTable(wave_end, true);
+
 GxGDE06::GxGDE06(GxIO_GreenSTM32F103V& io)
-  : GxEPD(GxGDE06_WIDTH, GxGDE06_HEIGHT), IO(io)
+  : GxEPD(GxGDE06_WIDTH, GxGDE06_HEIGHT),
+    _waveforms(0), _waveform_set(-1), _waveform_tables(0), _temperature(25), IO(io)
 {
+  use_builtin_waveform();
 }
 
 template <typename T> static inline void
@@ -39,6 +45,9 @@ swap(T& a, T& b)
   b = t;
 }
 
+#define NO_ROW 0xFFFFFFFF // for build_row()
+#define PICTURE_SIZE (uint32_t(GxGDE06_WIDTH / 4) * GxGDE06_HEIGHT) // 4 gray levels
+
 void GxGDE06::drawPixel(int16_t x, int16_t y, uint16_t color)
 {
   if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
@@ -61,33 +70,47 @@ void GxGDE06::drawPixel(int16_t x, int16_t y, uint16_t color)
   }
   uint32_t i = x / 8 + y * GxGDE06_WIDTH / 8;
   if (i >= GxGDE06_BUFFER_SIZE) return; // for reduced buffer size
-  if (color == GxEPD_BLACK) epd_buffer[i] = (epd_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
-  else if (color == GxEPD_WHITE) epd_buffer[i] = (epd_buffer[i] | (1 << (7 - x % 8)));
-  else
+  _fillMask(epd_buffer + i, 1 << (7 - x % 8), _isWhite(color));
+}
+
+void GxGDE06::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDE06::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDE06::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  bool white = _isWhite(color);
+  int16_t ye = GxGDE06_BUFFER_SIZE / (GxGDE06_WIDTH / 8); // for reduced buffer size
+  if (ye > y + h) ye = y + h;
+  for (int16_t y1 = y; y1 < ye; y1++)
   {
-    uint16_t brightness = ((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) & (color & 0x001F);
-    if (brightness < 3 * 128) (epd_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
-    else epd_buffer[i] = (epd_buffer[i] | (1 << (7 - x % 8)));
+    _fillBits(epd_buffer + uint32_t(y1) * (GxGDE06_WIDTH / 8), x, w, white);
   }
 }
 
+bool GxGDE06::_isWhite(uint16_t color)
+{
+  if (color == GxEPD_BLACK) return false;
+  if (color == GxEPD_WHITE) return true;
+  uint16_t brightness = _brightness(color);
+  return (brightness >= 3 * 128);
+}
+
 void GxGDE06::init(void)
 {
   IO.init();
-  init_wave_table();
 }
 
 void GxGDE06::fillScreen(uint16_t color)
 {
-  uint8_t data;
-  if (color == GxEPD_BLACK) data = 0x00;
-  else if (color == GxEPD_WHITE) data = 0xFF;
-  else
-  {
-    uint16_t brightness = ((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) & (color & 0x001F);
-    if (brightness < 3 * 128)  data = 0x00;
-    else data = 0xFF;
-  }
+  uint8_t data = _isWhite(color) ? 0xFF : 0x00;
   for (uint32_t x = 0; x < GxGDE06_BUFFER_SIZE; x++)
   {
     (epd_buffer)[x] = data;
@@ -104,24 +127,17 @@ void GxGDE06::drawPicture(const uint8_t *picture, uint32_t size)
   IO.powerOn();
   delay(25);
   clear_display();
-  for (uint16_t frame = 0; frame < GxGDE06_FRAME_END_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_end_size; frame++)
   {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
-      uint32_t x = line * (GxGDE06_WIDTH / 4);
-      uint16_t i = 0;
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE) && (x < size); i++, x++)
-      {
-        row_buffer[i] = wave_end_table[picture[x]][frame];
-      }
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE); i++)
-      {
-        row_buffer[i] = wave_end_table[0xFF][frame];
-      }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+      build_row(wave_end_table[frame], picture, uint32_t(line) * (GxGDE06_WIDTH / 4), size, 0xFF, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -132,34 +148,19 @@ void GxGDE06::drawBitmap(const uint8_t *bitmap, uint32_t size)
   IO.powerOn();
   delay(25);
   clear_display();
-  for (uint16_t frame = 0; frame < GxGDE06_FRAME_END_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_end_size; frame++)
   {
+    uint8_t bw_table[16];
+    init_bw_table(bw_table, wave_end_table[frame]);
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
-      uint32_t x = line * (GxGDE06_WIDTH / 8);
-      uint16_t i = 0;
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE) && (x < size); i++)
-      {
-        if (0 == i % 2)
-        {
-          uint8_t grey8b = bw2grey[(bitmap[x] & 0xF0) >> 4];
-          row_buffer[i] = wave_end_table[grey8b][frame];
-        }
-        else
-        {
-          uint8_t grey8b = bw2grey[bitmap[x] & 0x0F];
-          row_buffer[i] = wave_end_table[grey8b][frame];
-          x++;
-        }
-      }
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE); i++)
-      {
-        row_buffer[i] = wave_end_table[0xFF][frame];
-      }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+      build_bw_row(bw_table, bitmap, uint32_t(line) * (GxGDE06_WIDTH / 8), size, 0xFF, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -167,14 +168,22 @@ void GxGDE06::drawBitmap(const uint8_t *bitmap, uint32_t size)
 
 void  GxGDE06::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  if (_isWhite(color))
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
-    {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-      drawPixel(x1, y1, pixelcolor);
-    }
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  int16_t ye = GxGDE06_BUFFER_SIZE / (GxGDE06_WIDTH / 8); // for reduced buffer size
+  if (ye > py + ph) ye = py + ph;
+  uint8_t bits[GxGDE06_WIDTH / 8 + 1];
+  for (int16_t y1 = py; y1 < ye; y1++)
+  {
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, false, false); // bit set is white, as in epd_buffer
+    _copyBits(epd_buffer + uint32_t(y1) * (GxGDE06_WIDTH / 8), px, pw, bits);
   }
 }
 
@@ -182,24 +191,17 @@ void GxGDE06::erasePicture(const uint8_t *picture, uint32_t size)
 {
   IO.powerOn();
   delay(25);
-  for (uint16_t frame = 0; frame < GxGDE06_FRAME_BEGIN_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_begin_size; frame++)
   {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
-      uint32_t x = line * (GxGDE06_WIDTH / 4);
-      uint16_t i = 0;
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE) && (x < size); i++, x++)
-      {
-        row_buffer[i] = wave_begin_table[picture[x]][frame];
-      }
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE); i++)
-      {
-        row_buffer[i] = wave_begin_table[0x00][frame];
-      }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+      build_row(wave_begin_table[frame], picture, uint32_t(line) * (GxGDE06_WIDTH / 4), size, 0x00, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -209,34 +211,19 @@ void GxGDE06::eraseBitmap(const uint8_t *bitmap, uint32_t size)
 {
   IO.powerOn();
   delay(25);
-  for (uint16_t frame = 0; frame < GxGDE06_FRAME_END_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_begin_size; frame++)
   {
+    uint8_t bw_table[16];
+    init_bw_table(bw_table, wave_begin_table[frame]);
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
-      uint32_t x = line * (GxGDE06_WIDTH / 8);
-      uint16_t i = 0;
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE) && (x < size); i++)
-      {
-        if (0 == i % 2)
-        {
-          uint8_t grey8b = bw2grey[(bitmap[x] & 0xF0) >> 4];
-          row_buffer[i] = wave_begin_table[grey8b][frame];
-        }
-        else
-        {
-          uint8_t grey8b = bw2grey[bitmap[x] & 0x0F];
-          row_buffer[i] = wave_begin_table[grey8b][frame];
-          x++;
-        }
-      }
-      for (; (i < GxGDE06_ROW_BUFFER_SIZE); i++)
-      {
-        row_buffer[i] = wave_end_table[0x00][frame];
-      }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+      build_bw_row(bw_table, bitmap, uint32_t(line) * (GxGDE06_WIDTH / 8), size, 0x00, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -258,6 +245,7 @@ void GxGDE06::DisplayTestPicture(const uint8_t *picture)
 
   for (uint16_t frame = 0; frame < 2; frame++)
   {
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
@@ -265,107 +253,257 @@ void GxGDE06::DisplayTestPicture(const uint8_t *picture)
       {
         row_buffer[i] = 0x00;
       }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    output_row(idle);
   }
 
-  for (uint16_t frame = 0; frame < GxGDE06_FRAME_END_SIZE - 2; frame++)
+  for (uint16_t frame = 0; frame < _frame_end_size - 2; frame++)
   {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
-      uint32_t x = line * (GxGDE06_WIDTH / 4);
-      for (uint16_t i = 0; i < GxGDE06_ROW_BUFFER_SIZE; i++, x++)
+      build_row(wave_end_table[frame], picture, uint32_t(line) * (GxGDE06_WIDTH / 4), PICTURE_SIZE, 0xFF, prev);
+      output_row(idle);
+    }
+    output_row(idle);
+  }
+  IO.powerOff();
+}
+
+// send row_buffer, or only advance the gate driver if row_buffer and the row sent before are of no drive;
+// idle tells if the row sent before is of no drive, false at start of scan
+void GxGDE06::output_row(bool& idle)
+{
+  bool zero = (row_buffer[0] == 0) && (memcmp(row_buffer, row_buffer + 1, GxGDE06_ROW_BUFFER_SIZE - 1) == 0);
+  if (zero && idle) IO.skip_row();
+  else IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+  idle = zero;
+}
+
+// row_buffer from the picture row at x through table (one frame of a wave table), fill after size;
+// prev is the row built before in this frame, NO_ROW at start of frame; row_buffer is kept for an equal row
+void GxGDE06::build_row(const uint8_t* table, const uint8_t* picture, uint32_t x, uint32_t size, uint8_t fill, uint32_t& prev)
+{
+  if (x + GxGDE06_ROW_BUFFER_SIZE <= size)
+  {
+    const uint8_t* row = picture + x;
+    if ((prev < size) && (memcmp(picture + prev, row, GxGDE06_ROW_BUFFER_SIZE) == 0))
+    {
+      prev = x;
+      return; // same as previous row, e.g. white space
+    }
+    prev = x;
+    if (uintptr_t(row) % 4 == 0)
+    {
+      // 4 bytes per read, little endian, first byte in lowest bits
+      const uint32_t* src = (const uint32_t*) row;
+      for (uint16_t i = 0; i < GxGDE06_ROW_BUFFER_SIZE; i += 4)
       {
-        row_buffer[i] = wave_end_table[picture[x]][frame];
+        uint32_t data = *src++;
+        row_buffer[i] = table[data & 0xFF];
+        row_buffer[i + 1] = table[(data >> 8) & 0xFF];
+        row_buffer[i + 2] = table[(data >> 16) & 0xFF];
+        row_buffer[i + 3] = table[data >> 24];
       }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    else
+    {
+      for (uint16_t i = 0; i < GxGDE06_ROW_BUFFER_SIZE; i++) row_buffer[i] = table[row[i]];
+    }
+    return;
   }
-  IO.powerOff();
+  if ((x >= size) && (prev == size)) return; // fill row, same as previous
+  uint16_t i = 0;
+  for (; (i < GxGDE06_ROW_BUFFER_SIZE) && (x + i < size); i++) row_buffer[i] = table[picture[x + i]];
+  for (; i < GxGDE06_ROW_BUFFER_SIZE; i++) row_buffer[i] = table[fill];
+  prev = (x >= size) ? size : NO_ROW;
 }
 
-void GxGDE06::init_wave_table(void)
+// as build_row(), for a b/w bitmap row at x, through bw_table from init_bw_table(), 2 bytes of row_buffer per bitmap byte
+void GxGDE06::build_bw_row(const uint8_t* bw_table, const uint8_t* bitmap, uint32_t x, uint32_t size, uint8_t fill, uint32_t& prev)
+{
+  const uint16_t row_size = GxGDE06_WIDTH / 8;
+  if (x + row_size <= size)
+  {
+    const uint8_t* row = bitmap + x;
+    if ((prev < size) && (memcmp(bitmap + prev, row, row_size) == 0))
+    {
+      prev = x;
+      return; // same as previous row, e.g. white space
+    }
+    prev = x;
+    if (uintptr_t(row) % 4 == 0)
+    {
+      // 4 bytes per read, little endian, first byte in lowest bits
+      const uint32_t* src = (const uint32_t*) row;
+      for (uint16_t i = 0; i < GxGDE06_ROW_BUFFER_SIZE; i += 8)
+      {
+        uint32_t data = *src++;
+        for (uint8_t j = 0; j < 8; j += 2, data >>= 8)
+        {
+          row_buffer[i + j] = bw_table[(data >> 4) & 0x0F];
+          row_buffer[i + j + 1] = bw_table[data & 0x0F];
+        }
+      }
+    }
+    else
+    {
+      for (uint16_t i = 0; i < row_size; i++)
+      {
+        row_buffer[2 * i] = bw_table[row[i] >> 4];
+        row_buffer[2 * i + 1] = bw_table[row[i] & 0x0F];
+      }
+    }
+    return;
+  }
+  if ((x >= size) && (prev == size)) return; // fill row, same as previous
+  uint16_t i = 0;
+  for (; (i < row_size) && (x + i < size); i++)
+  {
+    row_buffer[2 * i] = bw_table[bitmap[x + i] >> 4];
+    row_buffer[2 * i + 1] = bw_table[bitmap[x + i] & 0x0F];
+  }
+  for (; i < row_size; i++)
+  {
+    row_buffer[2 * i] = bw_table[fill >> 4];
+    row_buffer[2 * i + 1] = bw_table[fill & 0x0F];
+  }
+  prev = (x >= size) ? size : NO_ROW;
+}
+
+// the bw2grey expansion folded into table (one frame of a wave table): 4 b/w pixels to 4 pixels drive
+void GxGDE06::init_bw_table(uint8_t* bw_table, const uint8_t* table)
+{
+  for (uint8_t n = 0; n < 16; n++) bw_table[n] = table[bw2grey[n]];
+}
+
+void GxGDE06::setWaveforms(GxEPD_Waveforms* waveforms)
+{
+  _waveforms = waveforms;
+  _waveform_set = -2; // force reselect
+  setTemperature(_temperature);
+}
+
+bool GxGDE06::setTemperature(int8_t temperature)
+{
+  _temperature = temperature;
+  int16_t set = _waveforms ? _waveforms->find(temperature) : -1;
+  if (set != _waveform_set)
+  {
+    free(_waveform_tables);
+    _waveform_tables = 0;
+    _waveform_set = set;
+    if (set >= 0)
+    {
+      _frame_begin_size = _waveforms->beginFrames(set);
+      _frame_end_size = _waveforms->endFrames(set);
+      if (!init_wave_table()) _waveform_set = -1; // out of memory
+    }
+    if (_waveform_set < 0) use_builtin_waveform();
+  }
+  return (_waveform_set >= 0);
+}
+
+void GxGDE06::use_builtin_waveform(void)
+{
+  _frame_begin_size = GxGDE06_FRAME_BEGIN_SIZE;
+  _frame_end_size = GxGDE06_FRAME_END_SIZE;
+  wave_begin_table = wave_begin_table_06.table;
+  wave_end_table = wave_end_table_06.table;
+}
+
+uint8_t GxGDE06::wave_drive(bool end, uint8_t level, uint16_t frame)
+{
+  if (_waveform_set >= 0) return _waveforms->drive(_waveform_set, end, level, frame);
+  return end ? wave_end[level][frame] : wave_begin[level][frame];
+}
+
+bool GxGDE06::init_wave_table(void)
 {
   int frame, num;
   unsigned char tmp, value;
-
+  _waveform_tables = (uint8_t*) malloc(uint32_t(_frame_begin_size + _frame_end_size) * WAVE_TABLE_SIZE);
+  if (!_waveform_tables) return false;
+  uint8_t (*begin_table)[WAVE_TABLE_SIZE] = (uint8_t (*)[WAVE_TABLE_SIZE]) _waveform_tables;
+  uint8_t (*end_table)[WAVE_TABLE_SIZE] = begin_table + _frame_begin_size;
 
   //wave_begin_table
-  for (frame = 0; frame < GxGDE06_FRAME_BEGIN_SIZE; frame++)
+  for (frame = 0; frame < _frame_begin_size; frame++)
   {
     for (num = 0; num < WAVE_TABLE_SIZE; num++)
     {
       tmp = 0;
-      tmp = wave_begin[(num >> 6) & 0x3][frame];
+      tmp = wave_drive(false, (num >> 6) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_begin[(num >> 4) & 0x3][frame];
+      tmp |= wave_drive(false, (num >> 4) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_begin[(num >> 2) & 0x3][frame];
+      tmp |= wave_drive(false, (num >> 2) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_begin[(num) & 0x3][frame];
+      tmp |= wave_drive(false, (num) & 0x3, frame);
 
       value = 0;
       value = (tmp << 6) & 0xc0;
       value += (tmp << 2) & 0x30;
       value += (tmp >> 2) & 0x0c;
       value += (tmp >> 6) & 0x03;
-      wave_begin_table[num][frame] = value;
+      begin_table[frame][num] = value;
     }
   }
 
   //wave_end_table
-  for (frame = 0; frame < GxGDE06_FRAME_END_SIZE; frame++)
+  for (frame = 0; frame < _frame_end_size; frame++)
   {
     for (num = 0; num < WAVE_TABLE_SIZE; num++)
     {
       tmp = 0;
-      tmp = wave_end[(num >> 6) & 0x3][frame];
+      tmp = wave_drive(true, (num >> 6) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_end[(num >> 4) & 0x3][frame];
+      tmp |= wave_drive(true, (num >> 4) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_end[(num >> 2) & 0x3][frame];
+      tmp |= wave_drive(true, (num >> 2) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_end[(num) & 0x3][frame];
+      tmp |= wave_drive(true, (num) & 0x3, frame);
 
       value = 0;
       value = (tmp << 6) & 0xc0;
       value += (tmp << 2) & 0x30;
       value += (tmp >> 2) & 0x0c;
       value += (tmp >> 6) & 0x03;
-      wave_end_table[num][frame] = value;
+      end_table[frame][num] = value;
     }
   }
+  wave_begin_table = begin_table;
+  wave_end_table = end_table;
+  return true;
 }
 
 void GxGDE06::clear_display()
 {
-  for (uint16_t frame = 0; frame < GxGDE06_FRAME_BEGIN_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_begin_size; frame++)
   {
+    memset(row_buffer, wave_begin_table[frame][0x00], GxGDE06_ROW_BUFFER_SIZE); // same for all rows
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDE06_HEIGHT; line++)
     {
-      for (uint16_t i = 0; (i < GxGDE06_ROW_BUFFER_SIZE); i++)
-      {
-        row_buffer[i] = wave_begin_table[0x00][frame];
-      }
-      IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDE06_ROW_BUFFER_SIZE);
+    output_row(idle);
   }
 }
 
@@ -30,6 +30,7 @@
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include "../GxEPD.h"
+#include "../GxEPD_Waveform.h"
 #include "../GxIO/GxIO_GreenSTM32F103V/GxIO_GreenSTM32F103V.h"
 
 #define GxGDE06_WIDTH 800
@@ -39,7 +40,7 @@
 #define GxGDE06_BUFFER_SIZE (GxGDE06_WIDTH * GxGDE06_HEIGHT / 8 - 6200) // b/w only
 
 #define GxGDE06_FRAME_BEGIN_SIZE    10
-const uint8_t wave_begin[4][GxGDE06_FRAME_BEGIN_SIZE] =
+constexpr uint8_t wave_begin[4][GxGDE06_FRAME_BEGIN_SIZE] =
 {
   0, 0, 0, 0, 1, 2, 2, 2, 2, 0,           //GC0->GC3
   0, 0, 0, 1, 1, 2, 2, 2, 2, 0,           //GC1->GC3
@@ -48,7 +49,7 @@ const uint8_t wave_begin[4][GxGDE06_FRAME_BEGIN_SIZE] =
 };
 
 #define GxGDE06_FRAME_END_SIZE 15
-const uint8_t wave_end[4][GxGDE06_FRAME_END_SIZE] =
+constexpr uint8_t wave_end[4][GxGDE06_FRAME_END_SIZE] =
 {
   0, 1, 1, 1, 1, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0,        //GC3->GC0
   0, 1, 1, 1, 1, 2, 2, 2, 2, 1, 1, 0, 0, 0, 0,        //GC3->GC1
@@ -77,28 +78,50 @@ class GxGDE06 : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
     // to full screen, filled with white if size is less, no update needed
     void drawPicture(const uint8_t *picture, uint32_t size); // 4 gray levels
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t *bitmap, uint32_t size); // black/white
-    // to buffer, may be cropped, drawPixel() used, update needed
+    // to buffer, may be cropped, update needed
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
     // undo last drawBitmap to prepare for next drawBitmap (turn display white);
     // any bitmap can be used, but real last bitmap gives slightly better result
     void erasePicture(const uint8_t *picture, uint32_t size);
     void eraseBitmap(const uint8_t *bitmap, uint32_t size);
     void clearDisplay(); // alternative to eraseBitmap, without bitmap
+    // waveform sets to select from by temperature, 0 for the built-in waveform only; waveforms must stay valid
+    void setWaveforms(GxEPD_Waveforms* waveforms);
+    // select the waveform set for the panel temperature in degree Celsius, builds its wave tables if changed;
+    // false if the built-in waveform is used, no set given or out of memory for the wave tables
+    bool setTemperature(int8_t temperature);
     void DisplayTestPicture(const uint8_t *picture);
     void fillScreenTest();
   private:
-    void init_wave_table(void);
+    bool init_wave_table(void); // of the selected waveform set, into allocated RAM; false if out of memory
+    void use_builtin_waveform(void);
+    uint8_t wave_drive(bool end, uint8_t level, uint16_t frame); // of the selected waveform
     void clear_display();
+    void output_row(bool& idle);
+    void build_row(const uint8_t* table, const uint8_t* picture, uint32_t x, uint32_t size, uint8_t fill, uint32_t& prev);
+    void build_bw_row(const uint8_t* bw_table, const uint8_t* bitmap, uint32_t x, uint32_t size, uint8_t fill, uint32_t& prev);
+    void init_bw_table(uint8_t* bw_table, const uint8_t* table);
+    bool _isWhite(uint16_t color); // buffer bit set is white
   private:
-    uint8_t wave_begin_table[WAVE_TABLE_SIZE][GxGDE06_FRAME_BEGIN_SIZE];
-    uint8_t wave_end_table[WAVE_TABLE_SIZE][GxGDE06_FRAME_END_SIZE];
+    // frame major, the table of a frame is contiguous for the row builder;
+    // in flash for the built-in waveform, in _waveform_tables for a waveform set
+    const uint8_t (*wave_begin_table)[WAVE_TABLE_SIZE];
+    const uint8_t (*wave_end_table)[WAVE_TABLE_SIZE];
     uint8_t row_buffer[GxGDE06_ROW_BUFFER_SIZE];
     epd_buffer_type epd_buffer;
+    GxEPD_Waveforms* _waveforms;
+    int16_t _waveform_set; // selected set of _waveforms, -1 for the built-in waveform
+    uint8_t* _waveform_tables; // allocated wave tables of the selected set
+    int8_t _temperature;
+    uint16_t _frame_begin_size, _frame_end_size; // of the selected waveform
     GxIO_GreenSTM32F103V& IO;
 };
 
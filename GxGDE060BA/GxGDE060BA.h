@@ -22,6 +22,7 @@
 
 #include <Arduino.h>
 #include "../GxEPD.h"
+#include "../GxEPD_Waveform.h"
 #include "../GxIO/GxIO_DESTM32L/GxIO_DESTM32L.h"
 
 #define GxGDE060BA_WIDTH 800
@@ -30,7 +31,7 @@
 #define GxGDE060BA_CL_DELAY 13 // this value produces the same CL period as the hex demo code
 
 #define GxGDE060BA_FRAME_BEGIN_SIZE  8
-const unsigned char wave_begin_60[4][GxGDE060BA_FRAME_BEGIN_SIZE] =
+constexpr unsigned char wave_begin_60[4][GxGDE060BA_FRAME_BEGIN_SIZE] =
 {
   0, 0, 0, 0, 2, 2, 2, 0, //GC0->GC3
   0, 0, 0, 1, 2, 2, 2, 0, //GC1->GC3
@@ -39,7 +40,7 @@ const unsigned char wave_begin_60[4][GxGDE060BA_FRAME_BEGIN_SIZE] =
 };
 
 #define GxGDE060BA_FRAME_END_SIZE  18
-const unsigned char wave_end_60[4][GxGDE060BA_FRAME_END_SIZE] =
+constexpr unsigned char wave_end_60[4][GxGDE060BA_FRAME_END_SIZE] =
 {
   0, 1, 1, 1, 2, 2, 2, 1, 1, 1, 2, 2, 2, 1, 1, 1, 0, 0, //GC3->GC0
   0, 1, 1, 1, 2, 2, 2, 1, 1, 1, 2, 2, 2, 1, 1, 0, 0, 0, //GC3->GC1
@@ -47,6 +48,16 @@ const unsigned char wave_end_60[4][GxGDE060BA_FRAME_END_SIZE] =
   0, 1, 1, 1, 2, 2, 2, 1, 1, 1, 2, 2, 2, 0, 0, 0, 0, 0, //GC3->GC3
 };
 
+// frames of the fast black/white update, as the white drive of GC0->GC3 in wave_begin_60
+#if !defined(GxGDE060BA_FAST_FRAMES)
+#define GxGDE060BA_FAST_FRAMES 3
+#endif
+
+// regions of updateWindowAsync() in flight at the same time
+#if !defined(GxGDE060BA_MAX_REGIONS)
+#define GxGDE060BA_MAX_REGIONS 4
+#endif
+
 #define GxGDE060BA_ROW_BUFFER_SIZE (GxGDE060BA_WIDTH / 4)
 
 // fixed, multiple of 64 and >= GxGDE060BA_ROW_BUFFER_SIZE
@@ -60,7 +71,9 @@ struct fmsc_sram_type
   epd_buffer_type epd_sram_buffer2;
 };
 
+#if !defined(FMSC_SRAM) // may be defined before, e.g. to host memory for simulation
 #define FMSC_SRAM ((fmsc_sram_type*)0x68000000) // NE3 PG10 on DESTM32-L
+#endif
 
 class GxGDE060BA : public GxEPD
 {
@@ -69,25 +82,88 @@ class GxGDE060BA : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
+    // fast black/white update, changed pixels only, to the nearest of black or white of their grey level;
+    // the screen state is kept for the next update, a full update() if the screen content is not known
+    void updateFast(void);
+    // update of the pixels inside the window only, in rotated coordinates (the SSD1607 class display classes take
+    // physical ones); changes outside stay for the next update,
+    // a full update() if the screen content is not known
+    void updateWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    // start an update of the pixels inside the window, in rotated coordinates; fast: black/white as updateFast();
+    // regions run concurrently, each with its own frame sequence, one frame per isBusy(); an overlapping window
+    // waits for the regions it overlaps; synchronous if out of memory, a full update() if the screen content is not known
+    void updateWindowAsync(int16_t x, int16_t y, int16_t w, int16_t h, bool fast = false);
+    // drives one frame of the regions in flight, true while a region is in flight
+    bool isBusy(void);
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t *bitmap, uint32_t size);
-    // to buffer, may be cropped, drawPixel() used, update needed
+    // to buffer, may be cropped, update needed
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
     // undo last drawBitmap to prepare for next drawBitmap (turn display white);
     // any bitmap can be used, but real last bitmap gives slightly better result
     void eraseBitmap(const uint8_t *bitmap, uint32_t size);
     void eraseDisplay(); // alternative to eraseBitmap, without bitmap
+    // waveform sets to select from by temperature, 0 for the built-in waveform only; waveforms must stay valid
+    void setWaveforms(GxEPD_Waveforms* waveforms);
+    // select the waveform set for the panel temperature in degree Celsius, builds its wave tables if changed;
+    // false if the built-in waveform is used, no set given or out of memory for the wave tables
+    bool setTemperature(int8_t temperature);
+    // mirror the image on the panel by the shift direction of the source and gate drivers, the buffer is unchanged,
+    // no cost in drawing and scanning; both is a rotation by 180 degrees, rotation r shows as (r + 2) % 4 at the cost of r;
+    // the next update is a full update
+    void setMirror(bool mirror_x, bool mirror_y);
     void DisplayTestPicture(uint8_t nr);
     void fillScreenTest();
   private:
-    void init_wave_table(void);
+    bool init_wave_table(void); // of the selected waveform set, into allocated RAM; false if out of memory
+    void use_builtin_waveform(void);
+    uint8_t wave_drive(bool end, uint8_t level, uint16_t frame); // of the selected waveform
+    void output_row(bool& idle);
+    void build_row(const uint8_t* table, const uint8_t* bitmap, uint32_t x, uint32_t size, uint32_t& prev);
+    uint8_t _greyLevel(uint16_t color); // 2 bit buffer value, 0 black .. 3 white
+    void init_transition_table(uint8_t (*table)[256], uint16_t* frame_mask);
+    uint8_t transition_drive(uint8_t old_level, uint8_t new_level, uint16_t frame);
+    // to full screen, from old_bitmap on screen, unchanged pixels are not driven; fast: black/white only
+    void update_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h); // physical, clipped
+    bool overlaps_region(uint16_t x, uint16_t y, uint16_t w, uint16_t h); // with a region in flight
+    void scan_regions(void);
+    void advance_regions(void);
+    // x, y, w, h physical, clipped: pixels outside the window are not driven
+    void drawTransition(const uint8_t *old_bitmap, const uint8_t *new_bitmap, bool fast = false,
+                        uint16_t x = 0, uint16_t y = 0, uint16_t w = GxGDE060BA_WIDTH, uint16_t h = GxGDE060BA_HEIGHT);
   private:
-    uint8_t wave_begin_table[WAVE_TABLE_SIZE][GxGDE060BA_FRAME_BEGIN_SIZE];
-    uint8_t wave_end_table[WAVE_TABLE_SIZE][GxGDE060BA_FRAME_END_SIZE];
+    // frame major, the table of a frame is contiguous for the row builder;
+    // in flash for the built-in waveform, in _waveform_tables for a waveform set
+    const uint8_t (*wave_begin_table)[WAVE_TABLE_SIZE];
+    const uint8_t (*wave_end_table)[WAVE_TABLE_SIZE];
+    // per frame: 2 pixels old and new grey level (old, old, new, new) to 2 pixels drive
+    const uint8_t (*transition_table)[256];
+    const uint16_t* transition_frame_mask; // transitions (old level * 4 + new level) driven in frame
     uint8_t row_buffer[GxGDE060BA_ROW_BUFFER_SIZE];
     epd_buffer_type* p_active_buffer;
     epd_buffer_type* p_erase_buffer;
+    uint16_t _grey_color; // last color mapped by _greyLevel()
+    uint8_t _grey_level;
+    bool _erase_buffer_valid; // p_erase_buffer is the content of the screen
+    GxEPD_Waveforms* _waveforms;
+    int16_t _waveform_set; // selected set of _waveforms, -1 for the built-in waveform
+    uint8_t* _waveform_tables; // allocated wave and transition tables of the selected set
+    int8_t _temperature;
+    struct region_type
+    {
+      uint16_t x, y, w, h; // physical, clipped
+      uint8_t* target; // window content at start, whole bytes of the rows, pixels outside the window as on screen
+      uint16_t present; // transitions present, bit old level * 4 + new level
+      uint16_t frame; // next frame to drive
+      bool fast;
+    };
+    region_type _regions[GxGDE060BA_MAX_REGIONS];
+    uint8_t _region_count;
+    uint16_t _frame_begin_size, _frame_end_size, _transition_size; // of the selected waveform
     GxIO_DESTM32L& IO;
 };
 
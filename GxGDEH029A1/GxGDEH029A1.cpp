@@ -29,6 +29,7 @@
 */
 
 #include "GxGDEH029A1.h"
+#include "../GxEPD_MirrorTable.h"
 
 #if defined(__AVR)
 #include <avr/pgmspace.h>
@@ -61,7 +62,9 @@ uint8_t RamDataEntryMode[] = {0x11, 0x01};  // Ram data entry mode
 GxGDEH029A1::GxGDEH029A1(GxIO& io, uint8_t rst, uint8_t busy) :
   GxEPD(GxGDEH029A1_WIDTH, GxGDEH029A1_HEIGHT),
   IO(io), _rst(rst), _busy(busy),
-  _current_page(-1), _using_partial_mode(false)
+  _current_page(-1), _using_partial_mode(false),
+  _dirty_x0(GxGDEH029A1_WIDTH), _dirty_y0(GxGDEH029A1_HEIGHT), _dirty_x1(0), _dirty_y1(0),
+  _row_hashes_valid(false), _update_pending(false)
 {
 }
 
@@ -105,10 +108,16 @@ void GxGDEH029A1::drawPixel(int16_t x, int16_t y, uint16_t color)
     i -= GxGDEH029A1_PAGE_SIZE * _current_page;
   }
 
+  uint8_t data = _buffer[i];
   if (!color)
-    _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
+    data = (data | (1 << (7 - x % 8)));
   else
-    _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    data = (data & (0xFF ^ (1 << (7 - x % 8))));
+  if (data != _buffer[i])
+  {
+    _buffer[i] = data;
+    _markDirty(x, y, x, y);
+  }
 }
 
 void GxGDEH029A1::init(void)
@@ -124,49 +133,97 @@ void GxGDEH029A1::init(void)
 void GxGDEH029A1::fillScreen(uint16_t color)
 {
   uint8_t data = (color == GxEPD_BLACK) ? 0xFF : 0x00;
-  for (uint16_t x = 0; x < sizeof(_buffer); x++)
+  for (uint16_t y = 0; y < sizeof(_buffer) / (GxGDEH029A1_WIDTH / 8); y++)
   {
-    _buffer[x] = data;
+    for (uint16_t x8 = 0; x8 < GxGDEH029A1_WIDTH / 8; x8++)
+    {
+      uint16_t idx = y * (GxGDEH029A1_WIDTH / 8) + x8;
+      if (_buffer[idx] != data)
+      {
+        _buffer[idx] = data;
+        _markDirty(x8 * 8, y, x8 * 8 + 7, y);
+      }
+    }
   }
 }
 
-void GxGDEH029A1::update(void)
+void GxGDEH029A1::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
 {
-  if (_current_page != -1) return;
-  _using_partial_mode = false;
-  _Init_Full();
-  _writeCommand(0x24);
-  for (uint16_t y = 0; y < GxGDEH029A1_HEIGHT; y++)
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDEH029A1::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDEH029A1::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  // rows in _buffer, the current page for paged drawing
+  int16_t first = (_current_page < 1) ? 0 : _current_page * GxGDEH029A1_PAGE_HEIGHT;
+  int16_t ys = (y > first) ? y : first;
+  int16_t ye = first + sizeof(_buffer) / (GxGDEH029A1_WIDTH / 8);
+  if (ye > y + h) ye = y + h;
+  for (int16_t y1 = ys; y1 < ye; y1++)
   {
-    for (uint16_t x = GxGDEH029A1_WIDTH / 8; x > 0; x--)
+    if (_fillBits(_buffer + uint16_t(y1 - first) * (GxGDEH029A1_WIDTH / 8), x, w, !color))
     {
-      uint16_t idx = y * (GxGDEH029A1_WIDTH / 8) + x - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
+      _markDirty(x, y1, x + w - 1, y1);
     }
   }
-  _Update_Full();
+}
+
+void GxGDEH029A1::update(void)
+{
+  if (_current_page != -1) return;
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_startUpdate()) return;
+  _waitWhileBusy("update display refresh");
   _PowerOff();
 }
 
+void GxGDEH029A1::updateAsync(void)
+{
+  if (_current_page != -1) return;
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (_startUpdate()) _update_pending = true;
+  else _updateDone();
+}
+
+bool GxGDEH029A1::isBusy(void)
+{
+  if (!_update_pending) return false;
+  if (IO.readBusy(_busy)) return true; // =1 BUSY
+  _update_pending = false;
+  _PowerOff();
+  _updateDone();
+  return false;
+}
+
 void GxGDEH029A1::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  if (color)
+  {
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  // rows in _buffer, the current page for paged drawing
+  int16_t first = (_current_page < 1) ? 0 : _current_page * GxGDEH029A1_PAGE_HEIGHT;
+  int16_t ys = (py > first) ? py : first;
+  int16_t ye = first + sizeof(_buffer) / (GxGDEH029A1_WIDTH / 8);
+  if (ye > py + ph) ye = py + ph;
+  uint8_t bits[GxGDEH029A1_WIDTH / 8 + 1];
+  for (int16_t y1 = ys; y1 < ye; y1++)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, true, true); // bit set is black
+    if (_copyBits(_buffer + uint16_t(y1 - first) * (GxGDEH029A1_WIDTH / 8), px, pw, bits))
     {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-#if defined(__AVR)
-      uint16_t pixelcolor = (pgm_read_byte(bitmap + i) & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-#else
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-#endif
-      drawPixel(x1, y1, pixelcolor);
+      _markDirty(px, y1, px + pw - 1, y1);
     }
   }
 }
@@ -178,6 +235,8 @@ void GxGDEH029A1::drawBitmap(const uint8_t *bitmap, uint32_t size)
 
 void GxGDEH029A1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_partial_update)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   if (using_partial_update)
   {
     _using_partial_mode = true; // remember
@@ -186,14 +245,7 @@ void GxGDEH029A1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_pa
     _SetRamArea(0x00, xPixelsPar / 8, yPixelsPar % 256, yPixelsPar / 256, 0x00, 0x00);  // X-source area,Y-gate area
     _SetRamPointer(0x00, yPixelsPar % 256, yPixelsPar / 256); // set ram
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEH029A1_BUFFER_SIZE; i++)
-    {
-#if defined(__AVR)
-      _writeData((i < size) ? pgm_read_byte(bitmap + i) : 0xFF);
-#else
-      _writeData((i < size) ? bitmap[i] : 0xFF);
-#endif
-    }
+    _writeBitmap(bitmap, size, GxGDEH029A1_BUFFER_SIZE, 0xFF);
     _Update_Part();
     _PowerOff();
   }
@@ -202,14 +254,7 @@ void GxGDEH029A1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_pa
     _using_partial_mode = false; // remember
     _Init_Full();
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEH029A1_BUFFER_SIZE; i++)
-    {
-#if defined(__AVR)
-      _writeData((i < size) ? pgm_read_byte(bitmap + i) : 0xFF);
-#else
-      _writeData((i < size) ? bitmap[i] : 0xFF);
-#endif
-    }
+    _writeBitmap(bitmap, size, GxGDEH029A1_BUFFER_SIZE, 0xFF);
     _Update_Full();
     _PowerOff();
   }
@@ -217,15 +262,14 @@ void GxGDEH029A1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_pa
 
 void GxGDEH029A1::eraseDisplay(bool using_partial_mode)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   if (using_partial_mode)
   {
     _using_partial_mode = true; // remember
     _Init_Part();
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEH029A1_BUFFER_SIZE; i++)
-    {
-      _writeData(0xFF);
-    }
+    _writeBitmap(0, 0, GxGDEH029A1_BUFFER_SIZE, 0xFF);
     _Update_Part();
     _PowerOff();
   }
@@ -233,10 +277,7 @@ void GxGDEH029A1::eraseDisplay(bool using_partial_mode)
   {
     _Init_Full();
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEH029A1_BUFFER_SIZE; i++)
-    {
-      _writeData(0xFF);
-    }
+    _writeBitmap(0, 0, GxGDEH029A1_BUFFER_SIZE, 0xFF);
     _Update_Full();
     _PowerOff();
   }
@@ -244,13 +285,15 @@ void GxGDEH029A1::eraseDisplay(bool using_partial_mode)
 
 void GxGDEH029A1::updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   //fillScreen(0x0);
   if (x >= GxGDEH029A1_WIDTH) return;
   if (y >= GxGDEH029A1_HEIGHT) return;
   uint16_t xe = min(GxGDEH029A1_WIDTH, x + w) - 1;
   uint16_t ye = min(GxGDEH029A1_HEIGHT, y + h) - 1;
   uint16_t xs_bx = x / 8;
-  uint16_t xe_bx = (xe + 7) / 8;
+  uint16_t xe_bx = xe / 8 + 1;
   uint16_t p_xs = (GxGDEH029A1_WIDTH - xe - 1) / 8;
   uint16_t p_xe = (GxGDEH029A1_WIDTH - x - 1) / 8;
   uint16_t p_ys = (GxGDEH029A1_HEIGHT - y - 1);
@@ -260,48 +303,58 @@ void GxGDEH029A1::updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = y; y1 <= ye; y1++)
-  {
-    for (int16_t x1 = xe_bx; x1 > xs_bx; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEH029A1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(y, ye, xs_bx, xe_bx);
   _Update_Part();
   delay(300);
   _SetRamArea(p_xs, p_xe, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = y; y1 <= ye; y1++)
-  {
-    for (int16_t x1 = xe_bx; x1 > xs_bx; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEH029A1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(y, ye, xs_bx, xe_bx);
   delay(300);
   _PowerOff();
 }
 
+void GxGDEH029A1::updateDirty()
+{
+  if (_dirty_x0 > _dirty_x1) return; // nothing changed since last update
+  updateWindow(_dirty_x0, _dirty_y0, _dirty_x1 - _dirty_x0 + 1, _dirty_y1 - _dirty_y0 + 1);
+  _resetDirty();
+}
+
+bool GxGDEH029A1::_startUpdate(void)
+{
+#if defined(__AVR)
+  uint16_t ys = 0, ye = GxGDEH029A1_HEIGHT - 1;
+#else
+  uint16_t ys, ye;
+  if (!_changedRows(ys, ye))
+  {
+    _resetDirty();
+    return false; // panel shows the buffer content already
+  }
+#endif
+  uint16_t p_ys = (GxGDEH029A1_HEIGHT - ys - 1);
+  uint16_t p_ye = (GxGDEH029A1_HEIGHT - ye - 1);
+  _using_partial_mode = false;
+  _Init_Full();
+  // controller RAM keeps the unchanged rows, upload the changed rows only
+  _SetRamArea(0x00, xPixelsPar / 8, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
+  _SetRamPointer(0x00, p_ys % 256, p_ys / 256); // set ram
+  _writeCommand(0x24);
+  _writeBufferRows(ys, ye, 0, GxGDEH029A1_WIDTH / 8);
+  // _Update_Full() without waiting for the refresh
+  _writeCommand(0x22);
+  _writeData(0xc4);
+  _writeCommand(0x20);
+  _resetDirty();
+  return true;
+}
+
 void GxGDEH029A1::_writeCommand(uint8_t command)
 {
-  //while (digitalRead(_busy));
-  if (digitalRead(_busy))
+  //while (IO.readBusy(_busy));
+  if (IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(command, HEX);
     _waitWhileBusy(str.c_str());
@@ -314,10 +367,52 @@ void GxGDEH029A1::_writeData(uint8_t data)
   IO.writeDataTransaction(data);
 }
 
+void GxGDEH029A1::_writeData(const uint8_t* data, uint16_t n)
+{
+  IO.writeDataTransaction(data, n);
+}
+
+void GxGDEH029A1::_writeBufferRows(uint16_t ys, uint16_t ye, uint16_t xs_bx, uint16_t xe_bx)
+{
+  // one data block per row, x bytes in reverse order, bit order reversed and inverted
+  uint8_t row[GxGDEH029A1_WIDTH / 8];
+  for (uint16_t y1 = ys; y1 <= ye; y1++)
+  {
+    uint16_t n = 0;
+    for (uint16_t x1 = xe_bx; x1 > xs_bx; x1--)
+    {
+      uint16_t idx = y1 * (GxGDEH029A1_WIDTH / 8) + x1 - 1;
+      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
+      row[n++] = GxEPD_mirrorInvert(data);
+    }
+    _writeData(row, n);
+  }
+}
+
+void GxGDEH029A1::_writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill)
+{
+  // through a local block, bitmap may be in PROGMEM on AVR, filled with fill after size
+  uint8_t block[GxGDEH029A1_WIDTH / 8];
+  uint32_t i = 0;
+  while (i < count)
+  {
+    uint16_t n = 0;
+    for (; (n < sizeof(block)) && (i < count); n++, i++)
+    {
+#if defined(__AVR)
+      block[n] = (i < size) ? pgm_read_byte(bitmap + i) : fill;
+#else
+      block[n] = (i < size) ? bitmap[i] : fill;
+#endif
+    }
+    _writeData(block, n);
+  }
+}
+
 void GxGDEH029A1::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
 {
-  //while (digitalRead(_busy)); // wait
-  if (digitalRead(_busy))
+  //while (IO.readBusy(_busy)); // wait
+  if (IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(pCommandData[0], HEX);
     _waitWhileBusy(str.c_str());
@@ -334,21 +429,57 @@ void GxGDEH029A1::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen
 
 void GxGDEH029A1::_waitWhileBusy(const char* comment)
 {
-  unsigned long start = micros();
+  //unsigned long start = micros();
   while (1)
   {
-    if (!digitalRead(_busy)) break;
+    if (!IO.readBusy(_busy)) break;
     delay(1);
   }
   if (comment)
   {
-    unsigned long elapsed = micros() - start;
+    //unsigned long elapsed = micros() - start;
     //Serial.print(comment);
     //Serial.print(" : ");
     //Serial.println(elapsed);
   }
 }
 
+void GxGDEH029A1::_markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+  if (x0 < _dirty_x0) _dirty_x0 = x0;
+  if (y0 < _dirty_y0) _dirty_y0 = y0;
+  if (x1 > _dirty_x1) _dirty_x1 = x1;
+  if (y1 > _dirty_y1) _dirty_y1 = y1;
+}
+
+void GxGDEH029A1::_resetDirty()
+{
+  _dirty_x0 = GxGDEH029A1_WIDTH;
+  _dirty_y0 = GxGDEH029A1_HEIGHT;
+  _dirty_x1 = 0;
+  _dirty_y1 = 0;
+}
+
+#if !defined(__AVR)
+bool GxGDEH029A1::_changedRows(uint16_t& ys, uint16_t& ye)
+{
+  ys = GxGDEH029A1_HEIGHT;
+  ye = 0;
+  for (uint16_t y = 0; y < GxGDEH029A1_HEIGHT; y++)
+  {
+    uint32_t hash = _hash32(_buffer + uint32_t(y) * (GxGDEH029A1_WIDTH / 8), GxGDEH029A1_WIDTH / 8);
+    if (!_row_hashes_valid || (hash != _row_hash[y]))
+    {
+      _row_hash[y] = hash;
+      if (y < ys) ys = y;
+      ye = y;
+    }
+  }
+  _row_hashes_valid = true;
+  return (ys <= ye);
+}
+#endif
+
 void GxGDEH029A1::_SetRamArea(uint8_t Xstart, uint8_t Xend, uint8_t Ystart, uint8_t Ystart1, uint8_t Yend, uint8_t Yend1)
 {
   _writeCommand(0x44);
@@ -440,20 +571,7 @@ void GxGDEH029A1::_drawCurrentPage()
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = 0; y1 < GxGDEH029A1_PAGE_HEIGHT; y1++)
-  {
-    for (int16_t x1 = GxGDEH029A1_WIDTH / 8; x1 > 0; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEH029A1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(0, GxGDEH029A1_PAGE_HEIGHT - 1, 0, GxGDEH029A1_WIDTH / 8);
   _Update_Part();
   delay(300);
 #if 1 // this is required
@@ -461,26 +579,15 @@ void GxGDEH029A1::_drawCurrentPage()
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = 0; y1 < GxGDEH029A1_PAGE_HEIGHT; y1++)
-  {
-    for (int16_t x1 = GxGDEH029A1_WIDTH / 8; x1 > 0; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEH029A1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(0, GxGDEH029A1_PAGE_HEIGHT - 1, 0, GxGDEH029A1_WIDTH / 8);
   delay(300);
 #endif
 }
 
 void GxGDEH029A1::drawPaged(void (*drawCallback)(void))
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   if (!_using_partial_mode)
   {
     eraseDisplay(false);
@@ -497,6 +604,7 @@ void GxGDEH029A1::drawPaged(void (*drawCallback)(void))
     //delay(2000);
   }
   _current_page = -1;
+  _resetDirty();
   _PowerOff();
 }
 
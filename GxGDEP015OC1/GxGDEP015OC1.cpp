@@ -28,6 +28,7 @@
        |-------------------------------------------------
 */
 #include "GxGDEP015OC1.h"
+#include "../GxEPD_MirrorTable.h"
 #include "BitmapExamples.h"
 
 #if defined(__AVR)
@@ -90,7 +91,9 @@ uint8_t RamDataEntryMode[] = {0x11, 0x01}; // Ram data entry mode
 GxGDEP015OC1::GxGDEP015OC1(GxIO& io, uint8_t rst, uint8_t busy) :
   GxEPD(GxGDEP015OC1_WIDTH, GxGDEP015OC1_HEIGHT),
   IO(io), _rst(rst), _busy(busy),
-  _current_page(-1), _using_partial_mode(false)
+  _current_page(-1), _using_partial_mode(false),
+  _dirty_x0(GxGDEP015OC1_WIDTH), _dirty_y0(GxGDEP015OC1_HEIGHT), _dirty_x1(0), _dirty_y1(0),
+  _row_hashes_valid(false), _update_pending(false)
 {
 }
 
@@ -134,10 +137,16 @@ void GxGDEP015OC1::drawPixel(int16_t x, int16_t y, uint16_t color)
     i -= GxGDEP015OC1_PAGE_SIZE * _current_page;
   }
 
+  uint8_t data = _buffer[i];
   if (!color)
-    _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
+    data = (data | (1 << (7 - x % 8)));
   else
-    _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    data = (data & (0xFF ^ (1 << (7 - x % 8))));
+  if (data != _buffer[i])
+  {
+    _buffer[i] = data;
+    _markDirty(x, y, x, y);
+  }
 }
 
 void GxGDEP015OC1::init(void)
@@ -153,49 +162,97 @@ void GxGDEP015OC1::init(void)
 void GxGDEP015OC1::fillScreen(uint16_t color)
 {
   uint8_t data = (color == GxEPD_BLACK) ? 0xFF : 0x00;
-  for (uint16_t x = 0; x < sizeof(_buffer); x++)
+  for (uint16_t y = 0; y < sizeof(_buffer) / (GxGDEP015OC1_WIDTH / 8); y++)
   {
-    _buffer[x] = data;
+    for (uint16_t x8 = 0; x8 < GxGDEP015OC1_WIDTH / 8; x8++)
+    {
+      uint16_t idx = y * (GxGDEP015OC1_WIDTH / 8) + x8;
+      if (_buffer[idx] != data)
+      {
+        _buffer[idx] = data;
+        _markDirty(x8 * 8, y, x8 * 8 + 7, y);
+      }
+    }
   }
 }
 
-void GxGDEP015OC1::update(void)
+void GxGDEP015OC1::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
 {
-  if (_current_page != -1) return;
-  _using_partial_mode = false;
-  _Init_Full();
-  _writeCommand(0x24);
-  for (uint16_t y = 0; y < GxGDEP015OC1_HEIGHT; y++)
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDEP015OC1::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDEP015OC1::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  // rows in _buffer, the current page for paged drawing
+  int16_t first = (_current_page < 1) ? 0 : _current_page * GxGDEP015OC1_PAGE_HEIGHT;
+  int16_t ys = (y > first) ? y : first;
+  int16_t ye = first + sizeof(_buffer) / (GxGDEP015OC1_WIDTH / 8);
+  if (ye > y + h) ye = y + h;
+  for (int16_t y1 = ys; y1 < ye; y1++)
   {
-    for (uint16_t x = GxGDEP015OC1_WIDTH / 8; x > 0; x--)
+    if (_fillBits(_buffer + uint16_t(y1 - first) * (GxGDEP015OC1_WIDTH / 8), x, w, !color))
     {
-      uint16_t idx = y * (GxGDEP015OC1_WIDTH / 8) + x - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
+      _markDirty(x, y1, x + w - 1, y1);
     }
   }
-  _Update_Full();
+}
+
+void GxGDEP015OC1::update(void)
+{
+  if (_current_page != -1) return;
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_startUpdate()) return;
+  _waitWhileBusy("update display refresh");
   _PowerOff();
 }
 
+void GxGDEP015OC1::updateAsync(void)
+{
+  if (_current_page != -1) return;
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (_startUpdate()) _update_pending = true;
+  else _updateDone();
+}
+
+bool GxGDEP015OC1::isBusy(void)
+{
+  if (!_update_pending) return false;
+  if (IO.readBusy(_busy)) return true; // =1 BUSY
+  _update_pending = false;
+  _PowerOff();
+  _updateDone();
+  return false;
+}
+
 void  GxGDEP015OC1::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  if (color)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  // rows in _buffer, the current page for paged drawing
+  int16_t first = (_current_page < 1) ? 0 : _current_page * GxGDEP015OC1_PAGE_HEIGHT;
+  int16_t ys = (py > first) ? py : first;
+  int16_t ye = first + sizeof(_buffer) / (GxGDEP015OC1_WIDTH / 8);
+  if (ye > py + ph) ye = py + ph;
+  uint8_t bits[GxGDEP015OC1_WIDTH / 8 + 1];
+  for (int16_t y1 = ys; y1 < ye; y1++)
+  {
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, true, true); // bit set is black
+    if (_copyBits(_buffer + uint16_t(y1 - first) * (GxGDEP015OC1_WIDTH / 8), px, pw, bits))
     {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-#if defined(__AVR)
-      uint16_t pixelcolor = (pgm_read_byte(bitmap + i) & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-#else
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-#endif
-      drawPixel(x1, y1, pixelcolor);
+      _markDirty(px, y1, px + pw - 1, y1);
     }
   }
 }
@@ -207,6 +264,8 @@ void GxGDEP015OC1::drawBitmap(const uint8_t *bitmap, uint32_t size)
 
 void GxGDEP015OC1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_partial_update)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   if (using_partial_update)
   {
     _using_partial_mode = true; // remember
@@ -215,14 +274,7 @@ void GxGDEP015OC1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_p
     _SetRamArea(0x00, xPixelsPar / 8, yPixelsPar % 256, yPixelsPar / 256, 0x00, 0x00);  // X-source area,Y-gate area
     _SetRamPointer(0x00, yPixelsPar % 256, yPixelsPar / 256); // set ram
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEP015OC1_BUFFER_SIZE; i++)
-    {
-#if defined(__AVR)
-      _writeData((i < size) ? pgm_read_byte(bitmap + i) : 0xFF);
-#else
-      _writeData((i < size) ? bitmap[i] : 0xFF);
-#endif
-    }
+    _writeBitmap(bitmap, size, GxGDEP015OC1_BUFFER_SIZE, 0xFF);
     _Update_Part();
     _PowerOff();
   }
@@ -231,14 +283,7 @@ void GxGDEP015OC1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_p
     _using_partial_mode = false; // remember
     _Init_Full();
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEP015OC1_BUFFER_SIZE; i++)
-    {
-#if defined(__AVR)
-      _writeData((i < size) ? pgm_read_byte(bitmap + i) : 0xFF);
-#else
-      _writeData((i < size) ? bitmap[i] : 0xFF);
-#endif
-    }
+    _writeBitmap(bitmap, size, GxGDEP015OC1_BUFFER_SIZE, 0xFF);
     _Update_Full();
     _PowerOff();
   }
@@ -246,15 +291,14 @@ void GxGDEP015OC1::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_p
 
 void GxGDEP015OC1::eraseDisplay(bool using_partial_mode)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   if (using_partial_mode)
   {
     _using_partial_mode = true; // remember
     _Init_Part();
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEP015OC1_BUFFER_SIZE; i++)
-    {
-      _writeData(0xFF);
-    }
+    _writeBitmap(0, 0, GxGDEP015OC1_BUFFER_SIZE, 0xFF);
     _Update_Part();
     _PowerOff();
   }
@@ -262,10 +306,7 @@ void GxGDEP015OC1::eraseDisplay(bool using_partial_mode)
   {
     _Init_Full();
     _writeCommand(0x24);
-    for (uint32_t i = 0; i < GxGDEP015OC1_BUFFER_SIZE; i++)
-    {
-      _writeData(0xFF);
-    }
+    _writeBitmap(0, 0, GxGDEP015OC1_BUFFER_SIZE, 0xFF);
     _Update_Full();
     _PowerOff();
   }
@@ -273,13 +314,15 @@ void GxGDEP015OC1::eraseDisplay(bool using_partial_mode)
 
 void GxGDEP015OC1::updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   //fillScreen(0x0);
   if (x >= GxGDEP015OC1_WIDTH) return;
   if (y >= GxGDEP015OC1_HEIGHT) return;
   uint16_t xe = min(GxGDEP015OC1_WIDTH, x + w) - 1;
   uint16_t ye = min(GxGDEP015OC1_HEIGHT, y + h) - 1;
   uint16_t xs_bx = x / 8;
-  uint16_t xe_bx = (xe + 7) / 8;
+  uint16_t xe_bx = xe / 8 + 1;
   uint16_t p_xs = (GxGDEP015OC1_WIDTH - xe - 1) / 8;
   uint16_t p_xe = (GxGDEP015OC1_WIDTH - x - 1) / 8;
   uint16_t p_ys = (GxGDEP015OC1_HEIGHT - y - 1);
@@ -289,48 +332,58 @@ void GxGDEP015OC1::updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = y; y1 <= ye; y1++)
-  {
-    for (int16_t x1 = xe_bx; x1 > xs_bx; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEP015OC1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(y, ye, xs_bx, xe_bx);
   _Update_Part();
   delay(300);
   _SetRamArea(p_xs, p_xe, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = y; y1 <= ye; y1++)
-  {
-    for (int16_t x1 = xe_bx; x1 > xs_bx; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEP015OC1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(y, ye, xs_bx, xe_bx);
   delay(300);
   _PowerOff();
 }
 
+void GxGDEP015OC1::updateDirty()
+{
+  if (_dirty_x0 > _dirty_x1) return; // nothing changed since last update
+  updateWindow(_dirty_x0, _dirty_y0, _dirty_x1 - _dirty_x0 + 1, _dirty_y1 - _dirty_y0 + 1);
+  _resetDirty();
+}
+
+bool GxGDEP015OC1::_startUpdate(void)
+{
+#if defined(__AVR)
+  uint16_t ys = 0, ye = GxGDEP015OC1_HEIGHT - 1;
+#else
+  uint16_t ys, ye;
+  if (!_changedRows(ys, ye))
+  {
+    _resetDirty();
+    return false; // panel shows the buffer content already
+  }
+#endif
+  uint16_t p_ys = (GxGDEP015OC1_HEIGHT - ys - 1);
+  uint16_t p_ye = (GxGDEP015OC1_HEIGHT - ye - 1);
+  _using_partial_mode = false;
+  _Init_Full();
+  // controller RAM keeps the unchanged rows, upload the changed rows only
+  _SetRamArea(0x00, xPixelsPar / 8, p_ys % 256, p_ys / 256, p_ye % 256, p_ye / 256); // X-source area,Y-gate area
+  _SetRamPointer(0x00, p_ys % 256, p_ys / 256); // set ram
+  _writeCommand(0x24);
+  _writeBufferRows(ys, ye, 0, GxGDEP015OC1_WIDTH / 8);
+  // _Update_Full() without waiting for the refresh
+  _writeCommand(0x22);
+  _writeData(0xc4);
+  _writeCommand(0x20);
+  _resetDirty();
+  return true;
+}
+
 void GxGDEP015OC1::_writeCommand(uint8_t command)
 {
-  //while (digitalRead(_busy));
-  if (digitalRead(_busy))
+  //while (IO.readBusy(_busy));
+  if (IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(command, HEX);
     _waitWhileBusy(str.c_str());
@@ -343,10 +396,52 @@ void GxGDEP015OC1::_writeData(uint8_t data)
   IO.writeDataTransaction(data);
 }
 
+void GxGDEP015OC1::_writeData(const uint8_t* data, uint16_t n)
+{
+  IO.writeDataTransaction(data, n);
+}
+
+void GxGDEP015OC1::_writeBufferRows(uint16_t ys, uint16_t ye, uint16_t xs_bx, uint16_t xe_bx)
+{
+  // one data block per row, x bytes in reverse order, bit order reversed and inverted
+  uint8_t row[GxGDEP015OC1_WIDTH / 8];
+  for (uint16_t y1 = ys; y1 <= ye; y1++)
+  {
+    uint16_t n = 0;
+    for (uint16_t x1 = xe_bx; x1 > xs_bx; x1--)
+    {
+      uint16_t idx = y1 * (GxGDEP015OC1_WIDTH / 8) + x1 - 1;
+      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
+      row[n++] = GxEPD_mirrorInvert(data);
+    }
+    _writeData(row, n);
+  }
+}
+
+void GxGDEP015OC1::_writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill)
+{
+  // through a local block, bitmap may be in PROGMEM on AVR, filled with fill after size
+  uint8_t block[GxGDEP015OC1_WIDTH / 8];
+  uint32_t i = 0;
+  while (i < count)
+  {
+    uint16_t n = 0;
+    for (; (n < sizeof(block)) && (i < count); n++, i++)
+    {
+#if defined(__AVR)
+      block[n] = (i < size) ? pgm_read_byte(bitmap + i) : fill;
+#else
+      block[n] = (i < size) ? bitmap[i] : fill;
+#endif
+    }
+    _writeData(block, n);
+  }
+}
+
 void GxGDEP015OC1::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
 {
-  //while (digitalRead(_busy)); // wait
-  if (digitalRead(_busy))
+  //while (IO.readBusy(_busy)); // wait
+  if (IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(pCommandData[0], HEX);
     _waitWhileBusy(str.c_str());
@@ -363,21 +458,57 @@ void GxGDEP015OC1::_writeCommandData(const uint8_t* pCommandData, uint8_t datale
 
 void GxGDEP015OC1::_waitWhileBusy(const char* comment)
 {
-  unsigned long start = micros();
+  //unsigned long start = micros();
   while (1)
   {
-    if (!digitalRead(_busy)) break;
+    if (!IO.readBusy(_busy)) break;
     delay(1);
   }
   if (comment)
   {
-    unsigned long elapsed = micros() - start;
+    //unsigned long elapsed = micros() - start;
     //Serial.print(comment);
     //Serial.print(" : ");
     //Serial.println(elapsed);
   }
 }
 
+void GxGDEP015OC1::_markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+  if (x0 < _dirty_x0) _dirty_x0 = x0;
+  if (y0 < _dirty_y0) _dirty_y0 = y0;
+  if (x1 > _dirty_x1) _dirty_x1 = x1;
+  if (y1 > _dirty_y1) _dirty_y1 = y1;
+}
+
+void GxGDEP015OC1::_resetDirty()
+{
+  _dirty_x0 = GxGDEP015OC1_WIDTH;
+  _dirty_y0 = GxGDEP015OC1_HEIGHT;
+  _dirty_x1 = 0;
+  _dirty_y1 = 0;
+}
+
+#if !defined(__AVR)
+bool GxGDEP015OC1::_changedRows(uint16_t& ys, uint16_t& ye)
+{
+  ys = GxGDEP015OC1_HEIGHT;
+  ye = 0;
+  for (uint16_t y = 0; y < GxGDEP015OC1_HEIGHT; y++)
+  {
+    uint32_t hash = _hash32(_buffer + uint32_t(y) * (GxGDEP015OC1_WIDTH / 8), GxGDEP015OC1_WIDTH / 8);
+    if (!_row_hashes_valid || (hash != _row_hash[y]))
+    {
+      _row_hash[y] = hash;
+      if (y < ys) ys = y;
+      ye = y;
+    }
+  }
+  _row_hashes_valid = true;
+  return (ys <= ye);
+}
+#endif
+
 void GxGDEP015OC1::_SetRamArea(uint8_t Xstart, uint8_t Xend, uint8_t Ystart, uint8_t Ystart1, uint8_t Yend, uint8_t Yend1)
 {
   _writeCommand(0x44);
@@ -415,6 +546,8 @@ void GxGDEP015OC1::_PowerOff(void)
 
 void GxGDEP015OC1::showDemoExample()
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   _Init_Full();
   delay(300);
 
@@ -490,18 +623,7 @@ void GxGDEP015OC1::_writeDisplayRam(uint16_t XSize, uint16_t YSize, const uint8_
   uint16_t xBytes = (XSize % 8 != 0) ? ((XSize / 8) + 1) : (XSize / 8);
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (uint16_t i = 0; i < YSize; i++)
-  {
-    for (uint16_t j = 0; j < xBytes; j++)
-    {
-#if defined(__AVR)
-      _writeData(pgm_read_byte(data));
-#else
-      _writeData(*data);
-#endif
-      data++;
-    }
-  }
+  _writeBitmap(data, uint32_t(xBytes) * YSize, uint32_t(xBytes) * YSize, 0x00);
 }
 
 void GxGDEP015OC1::_writeDisplayRamMono(uint16_t XSize, uint16_t YSize, uint8_t value)
@@ -510,13 +632,7 @@ void GxGDEP015OC1::_writeDisplayRamMono(uint16_t XSize, uint16_t YSize, uint8_t
   uint16_t xBytes = (XSize + 7) / 8;
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (uint16_t i = 0; i < YSize; i++)
-  {
-    for (uint16_t j = 0; j < xBytes; j++)
-    {
-      _writeData(value);
-    }
-  }
+  _writeBitmap(0, 0, uint32_t(xBytes) * YSize, value);
 }
 
 void GxGDEP015OC1::_partial_display(uint8_t RAM_XST, uint8_t RAM_XEND, uint8_t RAM_YST, uint8_t RAM_YST1, uint8_t RAM_YEND, uint8_t RAM_YEND1)
@@ -627,20 +743,7 @@ void GxGDEP015OC1::_drawCurrentPage()
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = 0; y1 < GxGDEP015OC1_PAGE_HEIGHT; y1++)
-  {
-    for (int16_t x1 = GxGDEP015OC1_WIDTH / 8; x1 > 0; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEP015OC1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(0, GxGDEP015OC1_PAGE_HEIGHT - 1, 0, GxGDEP015OC1_WIDTH / 8);
   _Update_Part();
   delay(300);
 #if 1 // this is required
@@ -648,26 +751,15 @@ void GxGDEP015OC1::_drawCurrentPage()
   _SetRamPointer(p_xs, p_ys % 256, p_ys / 256); // set ram
   _waitWhileBusy();
   _writeCommand(0x24);
-  for (int16_t y1 = 0; y1 < GxGDEP015OC1_PAGE_HEIGHT; y1++)
-  {
-    for (int16_t x1 = GxGDEP015OC1_WIDTH / 8; x1 > 0; x1--)
-    {
-      uint16_t idx = y1 * (GxGDEP015OC1_WIDTH / 8) + x1 - 1;
-      uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00;
-      uint8_t mirror = 0x00;
-      for (uint8_t i = 0; i < 8; i++)
-      {
-        mirror |= ((data >> i) & 0x01) << (7 - i);
-      }
-      _writeData(~mirror);
-    }
-  }
+  _writeBufferRows(0, GxGDEP015OC1_PAGE_HEIGHT - 1, 0, GxGDEP015OC1_WIDTH / 8);
   delay(300);
 #endif
 }
 
 void GxGDEP015OC1::drawPaged(void (*drawCallback)(void))
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // controller RAM written directly
   if (!_using_partial_mode)
   {
     eraseDisplay(false);
@@ -684,6 +776,7 @@ void GxGDEP015OC1::drawPaged(void (*drawCallback)(void))
     //delay(2000);
   }
   _current_page = -1;
+  _resetDirty();
   _PowerOff();
 }
 
@@ -71,15 +71,24 @@ class GxGDEP015OC1 : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // 0x0 black, >0x0 white, to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
-    // to buffer, may be cropped, drawPixel() used, update needed, Adafruit_GFX format
+    // start update, return without waiting for refresh, isBusy() completes it
+    void updateAsync(void);
+    bool isBusy(void);
+    // to buffer, may be cropped, update needed, Adafruit_GFX format
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t *bitmap, uint32_t size); 
     void drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_partial_update);
     void eraseDisplay(bool using_partial_update = false);
-    // partial update
+    // partial update of the window, in physical coordinates of the buffer, not rotated by setRotation();
+    // the updateWindow() of GxGDEW042T2, GxGDEW075T8 and the HD parallel display classes take rotated coordinates
     void updateWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    // partial update of the area changed by drawPixel() or fillScreen() since the last update
+    void updateDirty();
     // paged drawing, for limited RAM, drawCallback() is called GxGDEP015OC1_PAGES times
     // each call of drawCallback() should draw the same
     void drawPaged(void (*drawCallback)(void));
@@ -87,6 +96,9 @@ class GxGDEP015OC1 : public GxEPD
     void showDemoExample();
   private:
     void _writeData(uint8_t data);
+    void _writeData(const uint8_t* data, uint16_t n);
+    void _writeBufferRows(uint16_t ys, uint16_t ye, uint16_t xs_bx, uint16_t xe_bx);
+    void _writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill);
     void _writeCommand(uint8_t command);
     void _writeCommandData(const uint8_t* pCommandData, uint8_t datalen);
     void _SetRamPointer(uint8_t addrX, uint8_t addrY, uint8_t addrY1);
@@ -105,6 +117,12 @@ class GxGDEP015OC1 : public GxEPD
     void _Display_Full(const uint8_t* DisBuffer, uint8_t Label);
     void _Display_Part(uint8_t xStart, uint8_t xEnd, unsigned long yStart, unsigned long yEnd, const uint8_t* DisBuffer, uint8_t Label);
     void _drawCurrentPage();
+    void _markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    void _resetDirty();
+    bool _startUpdate(void); // false if nothing changed
+#if !defined(__AVR)
+    bool _changedRows(uint16_t& ys, uint16_t& ye); // since last update(), updates row hashes
+#endif
   protected:
 #if defined(__AVR)
     uint8_t _buffer[GxGDEP015OC1_PAGE_SIZE];
@@ -114,10 +132,16 @@ class GxGDEP015OC1 : public GxEPD
 
   private:
     GxIO& IO;
-    int16_t _current_page;
-    bool _using_partial_mode;
     uint8_t _rst;
     uint8_t _busy;
+    int16_t _current_page;
+    bool _using_partial_mode;
+    uint16_t _dirty_x0, _dirty_y0, _dirty_x1, _dirty_y1; // bounding box of changes, physical
+    bool _row_hashes_valid; // _row_hash[] matches controller RAM
+    bool _update_pending; // updateAsync() refresh not yet completed
+#if !defined(__AVR)
+    uint32_t _row_hash[GxGDEP015OC1_HEIGHT]; // of rows last sent by update()
+#endif
 };
 
 #define GxEPD_Class GxGDEP015OC1
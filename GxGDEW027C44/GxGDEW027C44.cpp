@@ -86,7 +86,7 @@ const uint8_t lut_wb[] = {
 
 GxGDEW027C44::GxGDEW027C44(GxIO& io, uint8_t rst, uint8_t busy)
   : GxEPD(GxGDEW027C44_WIDTH, GxGDEW027C44_HEIGHT),
-    IO(io), _rst(rst), _busy(busy)
+    IO(io), _rst(rst), _busy(busy), _update_pending(false), _profile(FULL_QUALITY), _warm(false)
 {
 }
 
@@ -120,21 +120,48 @@ void GxGDEW027C44::drawPixel(int16_t x, int16_t y, uint16_t color)
   }
   uint16_t i = x / 8 + y * GxGDEW027C44_WIDTH / 8;
   if (i >= GxGDEW027C44_BUFFER_SIZE) return; // for reduced buffer size
-  _black_buffer[i] = (_black_buffer[i] & (0xFF ^ (1 << (7 - x % 8)))); // white
-  _red_buffer[i] = (_red_buffer[i] & (0xFF ^ (1 << (7 - x % 8)))); // white
-  if (color == GxEPD_WHITE) return;
-  else if (color == GxEPD_BLACK) _black_buffer[i] = (_black_buffer[i] | (1 << (7 - x % 8)));
-  else if (color == GxEPD_RED) _red_buffer[i] = (_red_buffer[i] | (1 << (7 - x % 8)));
-  else
+  bool black, red;
+  _colorBits(color, black, red);
+  _fillMask(_black_buffer + i, 1 << (7 - x % 8), black);
+  _fillMask(_red_buffer + i, 1 << (7 - x % 8), red);
+}
+
+void GxGDEW027C44::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDEW027C44::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDEW027C44::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  bool black, red;
+  _colorBits(color, black, red);
+  int16_t ye = GxGDEW027C44_BUFFER_SIZE / (GxGDEW027C44_WIDTH / 8); // for reduced buffer size
+  if (ye > y + h) ye = y + h;
+  for (int16_t y1 = y; y1 < ye; y1++)
   {
-    if ((color & 0xF100) > (0xF100 / 2)) _red_buffer[i] = (_red_buffer[i] | (1 << (7 - x % 8)));
-    else if ((((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) & (color & 0x001F)) < 3 * 255 / 2)
-    {
-      _black_buffer[i] = (_black_buffer[i] | (1 << (7 - x % 8)));
-    }
+    uint16_t i = uint16_t(y1) * (GxGDEW027C44_WIDTH / 8);
+    _fillBits(_black_buffer + i, x, w, black);
+    _fillBits(_red_buffer + i, x, w, red);
   }
 }
 
+void GxGDEW027C44::_colorBits(uint16_t color, bool& black, bool& red)
+{
+  black = false;
+  red = false;
+  if (color == GxEPD_WHITE);
+  else if (color == GxEPD_BLACK) black = true;
+  else if (color == GxEPD_RED) red = true;
+  else if ((color & 0xF100) > (0xF100 / 2)) red = true;
+  else if (_brightness(color) < 3 * 255 / 2) black = true;
+}
+
 
 void GxGDEW027C44::init(void)
 {
@@ -148,17 +175,12 @@ void GxGDEW027C44::init(void)
 
 void GxGDEW027C44::fillScreen(uint16_t color)
 {
-  uint8_t black = 0x00;
-  uint8_t red = 0x00;
-  if (color == GxEPD_WHITE);
-  else if (color == GxEPD_BLACK) black = 0xFF;
-  else if (color == GxEPD_RED) red = 0xFF;
-  else if ((color & 0xF100) > (0xF100 / 2))  red = 0xFF;
-  else if ((((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) & (color & 0x001F)) < 3 * 255 / 2) black = 0xFF;
+  bool black, red;
+  _colorBits(color, black, red);
   for (uint16_t x = 0; x < GxGDEW027C44_BUFFER_SIZE; x++)
   {
-    _black_buffer[x] = black;
-    _red_buffer[x] = red;
+    _black_buffer[x] = black ? 0xFF : 0x00;
+    _red_buffer[x] = red ? 0xFF : 0x00;
   }
 }
 
@@ -167,37 +189,71 @@ void GxGDEW027C44::update(void)
   drawPicture(_black_buffer, _red_buffer, GxGDEW027C44_BUFFER_SIZE);
 }
 
+void GxGDEW027C44::updateAsync(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _startPicture(_black_buffer, _red_buffer, GxGDEW027C44_BUFFER_SIZE);
+  _update_pending = true;
+}
+
+bool GxGDEW027C44::isBusy(void)
+{
+  if (!_update_pending) return false;
+  if (IO.readBusy(_busy) == 0) return true; // =0 BUSY
+  _update_pending = false;
+  _sleep();
+  _updateDone();
+  return false;
+}
+
+void GxGDEW027C44::setRefreshProfile(RefreshProfile profile)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _profile = profile;
+}
+
+uint32_t GxGDEW027C44::refreshTime(RefreshProfile profile)
+{
+  // frames of the LUT at the frame rate of the profile
+  return _lutFrames(lut_ww) * 1000 / _frameRate(profile);
+}
+
+bool GxGDEW027C44::setTemperature(int8_t temperature)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _warm = (temperature >= GxGDEW027C44_WARM_TEMPERATURE);
+#if defined(GxGDEW027C44_WARM_FRAME_RATE)
+  return _warm;
+#else
+  return false;
+#endif
+}
+
+uint16_t GxGDEW027C44::_frameRate(RefreshProfile profile)
+{
+  uint16_t hz = (profile == FULL_QUALITY) ? 100 : 150;
+#if defined(GxGDEW027C44_WARM_FRAME_RATE)
+  if (_warm) hz += 50; // the panel responds faster when warm, untested
+#endif
+  return hz;
+}
+
 void GxGDEW027C44::drawPicture(const uint8_t* black_bitmap, const uint8_t* red_bitmap, uint32_t size)
 {
-  _wakeUp();
-  _writeCommand(0x10);
-  for (uint32_t i = 0; i < GxGDEW027C44_BUFFER_SIZE; i++)
-  {
-    _writeData((i < size) ? black_bitmap[i] : 0x00);
-  }
-  _writeCommand(0x13);
-  for (uint32_t i = 0; i < GxGDEW027C44_BUFFER_SIZE; i++)
-  {
-    _writeData((i < size) ? red_bitmap[i] : 0x00);
-  }
-  _writeCommand(0x12);      //display refresh
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _startPicture(black_bitmap, red_bitmap, size);
   _waitWhileBusy("update display refresh");
   _sleep();
 }
 
 void GxGDEW027C44::drawBitmap(const uint8_t* bitmap, uint32_t size)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
   _wakeUp();
   _writeCommand(0x10);
-  for (uint32_t i = 0; i < GxGDEW027C44_BUFFER_SIZE; i++)
-  {
-    _writeData((i < size) ? bitmap[i] : 0x00);
-  }
+  _writeBitmap(bitmap, size, GxGDEW027C44_BUFFER_SIZE, 0x00);
   _writeCommand(0x13);
-  for (uint32_t i = 0; i < GxGDEW027C44_BUFFER_SIZE; i++)
-  {
-    _writeData(0);
-  }
+  _writeBitmap(0, 0, GxGDEW027C44_BUFFER_SIZE, 0x00);
   _writeCommand(0x12);      //display refresh
   _waitWhileBusy("update display refresh");
   _sleep();
@@ -205,21 +261,43 @@ void GxGDEW027C44::drawBitmap(const uint8_t* bitmap, uint32_t size)
 
 void  GxGDEW027C44::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  bool black, red;
+  _colorBits(color, black, red);
+  if (!black && !red)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
-    {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-      drawPixel(x1, y1, pixelcolor);
-    }
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
   }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  int16_t ye = GxGDEW027C44_BUFFER_SIZE / (GxGDEW027C44_WIDTH / 8); // for reduced buffer size
+  if (ye > py + ph) ye = py + ph;
+  uint8_t bits[GxGDEW027C44_WIDTH / 8 + 1];
+  for (int16_t y1 = py; y1 < ye; y1++)
+  {
+    uint16_t i = uint16_t(y1) * (GxGDEW027C44_WIDTH / 8);
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, false, true); // bit set is color
+    _copyBits((black ? _black_buffer : _red_buffer) + i, px, pw, bits);
+    _fillBits((black ? _red_buffer : _black_buffer) + i, px, pw, false);
+  }
+}
+
+void GxGDEW027C44::_startPicture(const uint8_t* black_bitmap, const uint8_t* red_bitmap, uint32_t size)
+{
+  _wakeUp();
+  _writeCommand(0x10);
+  _writeBitmap(black_bitmap, size, GxGDEW027C44_BUFFER_SIZE, 0x00);
+  _writeCommand(0x13);
+  _writeBitmap(red_bitmap, size, GxGDEW027C44_BUFFER_SIZE, 0x00);
+  _writeCommand(0x12);      //display refresh
 }
 
 void GxGDEW027C44::_writeCommand(uint8_t command)
 {
-  //while (!digitalRead(_busy));
-  if (!digitalRead(_busy))
+  //while (!IO.readBusy(_busy));
+  if (!IO.readBusy(_busy))
   {
     String str = String("command 0x") + String(command, HEX);
     _waitWhileBusy(str.c_str());
@@ -232,17 +310,38 @@ void GxGDEW027C44::_writeData(uint8_t data)
   IO.writeDataTransaction(data);
 }
 
+void GxGDEW027C44::_writeData(const uint8_t* data, uint16_t n)
+{
+  IO.writeDataTransaction(data, n);
+}
+
+void GxGDEW027C44::_writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill)
+{
+  // through a local block, filled with fill after size
+  uint8_t block[GxGDEW027C44_WIDTH / 8];
+  uint32_t i = 0;
+  while (i < count)
+  {
+    uint16_t n = 0;
+    for (; (n < sizeof(block)) && (i < count); n++, i++)
+    {
+      block[n] = (i < size) ? bitmap[i] : fill;
+    }
+    _writeData(block, n);
+  }
+}
+
 void GxGDEW027C44::_waitWhileBusy(const char* comment)
 {
-  unsigned long start = micros();
+  //unsigned long start = micros();
   while (1)
   {
-    if (digitalRead(_busy) == 1) break;
+    if (IO.readBusy(_busy) == 1) break;
     delay(1);
   }
   if (comment)
   {
-    unsigned long elapsed = micros() - start;
+    //    unsigned long elapsed = micros() - start;
     //    Serial.print(comment);
     //    Serial.print(" : ");
     //    Serial.println(elapsed);
@@ -299,7 +398,7 @@ void GxGDEW027C44::_wakeUp()
   _writeData(0xaf);   //KW-BF   KWR-AF  BWROTP 0f
 
   _writeCommand(0x30);      //PLL�趨 // define by OTP
-  _writeData (0x3a);       //3A 100HZ   29 150Hz 39 200HZ 31 171HZ
+  _writeData (_pllSetting(_frameRate(_profile))); //3A 100HZ   29 150Hz 39 200HZ 31 171HZ
 
   _writeCommand(0x61);      //�����趨 // define by OTP
   _writeData (0x00);
@@ -323,37 +422,21 @@ void GxGDEW027C44::_sleep(void)
 
 void GxGDEW027C44::_writeLUT(void)
 {
-  unsigned int count;
   {
     _writeCommand(0x20);							//vcom
-    for (count = 0; count < 44; count++)
-    {
-      _writeData(lut_vcomDC[count]);
-    }
+    _writeData(lut_vcomDC, 44);
 
     _writeCommand(0x21);							//ww --
-    for (count = 0; count < 42; count++)
-    {
-      _writeData(lut_ww[count]);
-    }
+    _writeData(lut_ww, 42);
 
     _writeCommand(0x22);							//bw r
-    for (count = 0; count < 42; count++)
-    {
-      _writeData(lut_bw[count]);
-    }
+    _writeData(lut_bw, 42);
 
     _writeCommand(0x23);							//wb w
-    for (count = 0; count < 42; count++)
-    {
-      _writeData(lut_bb[count]);
-    }
+    _writeData(lut_bb, 42);
 
     _writeCommand(0x24);							//bb b
-    for (count = 0; count < 42; count++)
-    {
-      _writeData(lut_wb[count]);
-    }
+    _writeData(lut_wb, 42);
   }
 }
 
@@ -40,6 +40,11 @@
 
 #define GxGDEW027C44_BUFFER_SIZE GxGDEW027C44_WIDTH * GxGDEW027C44_HEIGHT / 8
 
+#if !defined(GxGDEW027C44_WARM_TEMPERATURE)
+#define GxGDEW027C44_WARM_TEMPERATURE 35 // degree Celsius, setTemperature() at or above runs the waveforms one frame rate step faster
+#endif
+// define GxGDEW027C44_WARM_FRAME_RATE to enable the faster frame rate for a warm panel, untested on the panel
+
 // mapping from DESTM32-S1 evaluation board to Wemos D1 mini
 
 // D10 : MOSI -> D7
@@ -63,26 +68,50 @@ class GxGDEW027C44 : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // 0x0 black, >0x0 white, to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
+    // start update, return without waiting for refresh, isBusy() completes it
+    void updateAsync(void);
+    bool isBusy(void);
     // to full screen, filled with white if size is less, no update needed
     void drawPicture(const uint8_t* black_bitmap, const uint8_t* red_bitmap, uint32_t size);
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t* bitmap, uint32_t size);
-    // to buffer, may be cropped, drawPixel() used, update needed
+    // to buffer, may be cropped, update needed
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+    // profile of the refreshes : FULL_QUALITY (default) at 100Hz, FULL_FAST the same waveform at 150Hz;
+    // no partial update with red, PARTIAL is FULL_FAST; FULL_FAST is untested on the panel
+    void setRefreshProfile(RefreshProfile profile);
+    // estimated duration of the refresh of profile in ms, not measured: the frames of the LUT by the frame rate,
+    // without data transfer
+    uint32_t refreshTime(RefreshProfile profile);
+    // panel temperature in degree Celsius from the application, e.g. of a sensor near the panel, no read-back without MISO;
+    // at or above GxGDEW027C44_WARM_TEMPERATURE the waveform runs at the next higher frame rate, true if so;
+    // only if GxGDEW027C44_WARM_FRAME_RATE is defined, untested on the panel; the default assumes a cold panel
+    bool setTemperature(int8_t temperature);
   private:
+    void _colorBits(uint16_t color, bool& black, bool& red); // color to buffer bits
+    void _startPicture(const uint8_t* black_bitmap, const uint8_t* red_bitmap, uint32_t size);
     void _writeData(uint8_t data);
+    void _writeData(const uint8_t* data, uint16_t n);
+    void _writeBitmap(const uint8_t* bitmap, uint32_t size, uint32_t count, uint8_t fill);
     void _writeCommand(uint8_t command);
     void _writeLUT();
     void _wakeUp();
     void _sleep();
     void _waitWhileBusy(const char* comment=0);
+    uint16_t _frameRate(RefreshProfile profile); // Hz
   private:
     uint8_t _black_buffer[GxGDEW027C44_BUFFER_SIZE];
     uint8_t _red_buffer[GxGDEW027C44_BUFFER_SIZE];
     GxIO& IO;
     uint8_t _rst;
     uint8_t _busy;
+    bool _update_pending; // updateAsync() refresh not yet completed
+    RefreshProfile _profile;
+    bool _warm; // setTemperature() at or above GxGDEW027C44_WARM_TEMPERATURE
 };
 
 #define GxEPD_Class GxGDEW027C44
@@ -84,9 +84,130 @@ const uint8_t lut_wb[] = {
 
 };
 
+// full update at a higher frame rate, the full waveform with each phase once
+const uint8_t lut_vcom0_fast[] =
+{
+  0x00, 0x17, 0x00, 0x00, 0x00, 0x01,
+  0x00, 0x17, 0x17, 0x00, 0x00, 0x01,
+  0x00, 0x0A, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x0E, 0x0E, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+};
+
+const uint8_t lut_ww_fast[] =
+{
+  0x40, 0x17, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x17, 0x17, 0x00, 0x00, 0x01,
+  0x40, 0x0A, 0x01, 0x00, 0x00, 0x01,
+  0xA0, 0x0E, 0x0E, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t lut_bw_fast[] =
+{
+  0x40, 0x17, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x17, 0x17, 0x00, 0x00, 0x01,
+  0x40, 0x0A, 0x01, 0x00, 0x00, 0x01,
+  0xA0, 0x0E, 0x0E, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t lut_bb_fast[] =
+{
+  0x80, 0x17, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x17, 0x17, 0x00, 0x00, 0x01,
+  0x80, 0x0A, 0x01, 0x00, 0x00, 0x01,
+  0x50, 0x0E, 0x0E, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t lut_wb_fast[] =
+{
+  0x80, 0x17, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x17, 0x17, 0x00, 0x00, 0x01,
+  0x80, 0x0A, 0x01, 0x00, 0x00, 0x01,
+  0x50, 0x0E, 0x0E, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// partial update, one short phase, only changed pixels are driven (old data 0x10, new data 0x13)
+const uint8_t lut_vcom0_partial[] =
+{
+  0x00, 0x19, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+};
+
+const uint8_t lut_ww_partial[] =
+{
+  0x00, 0x19, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t lut_bw_partial[] =
+{
+  0x80, 0x19, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t lut_wb_partial[] =
+{
+  0x40, 0x19, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t lut_bb_partial[] =
+{
+  0x00, 0x19, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// the LUTs of the refresh profiles, for commands 0x20 .. 0x24
+static const uint8_t* const luts_quality[] = {lut_vcom0, lut_ww, lut_bw, lut_wb, lut_bb};
+static const uint8_t* const luts_fast[] = {lut_vcom0_fast, lut_ww_fast, lut_bw_fast, lut_wb_fast, lut_bb_fast};
+static const uint8_t* const luts_partial[] = {lut_vcom0_partial, lut_ww_partial, lut_bw_partial, lut_wb_partial, lut_bb_partial};
+
 GxGDEW042T2::GxGDEW042T2(GxIO& io, uint8_t rst, uint8_t busy)
   : GxEPD(GxGDEW042T2_WIDTH, GxGDEW042T2_HEIGHT),
-    IO(io), _rst(rst), _busy(busy)
+    IO(io), _rst(rst), _busy(busy),
+    _row_hashes_valid(false), _update_pending(false), _hibernating(true),
+    _profile(FULL_QUALITY), _warm(false), _partial_update(false), _update_ys(0), _update_ye(0)
 {
   // do not init hw here, doesn't work
 }
@@ -146,68 +267,287 @@ void GxGDEW042T2::fillScreen(uint16_t color)
   }
 }
 
-void GxGDEW042T2::update(void)
+void GxGDEW042T2::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
 {
-  uint32_t i;
-  uint8_t data;
-  _wakeUp();
-  IO.writeCommandTransaction(0x13);
-  for (i = 0; i < GxGDEW042T2_BUFFER_SIZE; i++)
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDEW042T2::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDEW042T2::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  for (int16_t y1 = y; y1 < y + h; y1++)
   {
-    data = _buffer[i];
-    IO.writeDataTransaction(~data);
+    _fillBits(_buffer + uint32_t(y1) * (GxGDEW042T2_WIDTH / 8), x, w, !color);
   }
-  IO.writeCommandTransaction(0x12);      //display refresh
+}
+
+void GxGDEW042T2::update(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_startUpdate()) return; // panel shows the buffer content already
   _waitWhileBusy("update display refresh");
-  _sleep();
+  _endUpdate();
+}
+
+void GxGDEW042T2::updateAsync(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (_startUpdate()) _update_pending = true;
+  else _updateDone();
+}
+
+bool GxGDEW042T2::isBusy(void)
+{
+  if (!_update_pending) return false;
+  if (IO.readBusy(_busy) == 0) return true; // =0 BUSY
+  _update_pending = false;
+  _endUpdate();
+  _updateDone();
+  return false;
+}
+
+void GxGDEW042T2::setRefreshProfile(RefreshProfile profile)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _profile = profile;
+}
+
+uint32_t GxGDEW042T2::refreshTime(RefreshProfile profile)
+{
+  // frames of the LUT at the frame rate of the profile
+  const uint8_t* lut = (profile == PARTIAL) ? lut_ww_partial : (profile == FULL_FAST) ? lut_ww_fast : lut_ww;
+  return _lutFrames(lut) * 1000 / _frameRate(profile);
+}
+
+bool GxGDEW042T2::setTemperature(int8_t temperature)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _warm = (temperature >= GxGDEW042T2_WARM_TEMPERATURE);
+#if defined(GxGDEW042T2_WARM_FRAME_RATE)
+  return _warm;
+#else
+  return false;
+#endif
+}
+
+uint16_t GxGDEW042T2::_frameRate(RefreshProfile profile)
+{
+  uint16_t hz = (profile == FULL_FAST) ? 100 : 50;
+#if defined(GxGDEW042T2_WARM_FRAME_RATE)
+  if (_warm) hz += 50; // the panel responds faster when warm, untested
+#endif
+  return hz;
 }
 
 void GxGDEW042T2::drawBitmap(const uint8_t *bitmap, uint32_t size)
 {
-  uint32_t i;
-  uint8_t data;
-  _wakeUp();
-  IO.writeCommandTransaction(0x13);
-  for (i = 0; i < GxGDEW042T2_BUFFER_SIZE; i++)
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // displayed image replaced
+  _powerOn();
+  _writeLUT((_profile == FULL_FAST) ? FULL_FAST : FULL_QUALITY);
+  _writeBitmap(0x10, bitmap, size); // old data, not used by the full LUT, for the next partial update
+  _writeBitmap(0x13, bitmap, size);
+  IO.writeCommandTransaction(0x12);      //display refresh
+  _waitWhileBusy("update display refresh");
+  _powerOff();
+}
+
+void GxGDEW042T2::drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_partial_update)
+{
+  if (!using_partial_update || _hibernating)
   {
-    data = (i < size) ? bitmap[i] : 0xFF;
-    IO.writeDataTransaction(data);
+    drawBitmap(bitmap, size); // full update if the controller doesn't have the displayed image
+    return;
   }
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // displayed image replaced
+  _powerOn();
+  _writeLUT(PARTIAL);
+  IO.writeCommandTransaction(0x91); // partial in
+  _setPartialWindow(0, 0, GxGDEW042T2_WIDTH, GxGDEW042T2_HEIGHT);
+  _writeBitmap(0x13, bitmap, size);
   IO.writeCommandTransaction(0x12);      //display refresh
-  _waitWhileBusy("update display refresh");
-  _sleep();
+  _waitWhileBusy("partial display refresh");
+  _writeBitmap(0x10, bitmap, size); // the displayed image, old data of the next partial update
+  IO.writeCommandTransaction(0x92); // partial out
+  _powerOff();
+}
+
+void GxGDEW042T2::updateWindow(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (_hibernating)
+  {
+    update(); // full update if the controller doesn't have the displayed image
+    return;
+  }
+  if (!_rotateRect(x, y, w, h)) return;
+  _row_hashes_valid = false; // rows updated in part
+  uint16_t xs8 = x / 8, xe8 = (x + w + 7) / 8; // bytes of the window in a row
+  _powerOn();
+  _writeLUT(PARTIAL);
+  IO.writeCommandTransaction(0x91); // partial in
+  _setPartialWindow(xs8 * 8, y, (xe8 - xs8) * 8, h);
+  _writeBuffer(0x13, xs8, xe8, y, y + h);
+  IO.writeCommandTransaction(0x12);      //display refresh
+  _waitWhileBusy("partial display refresh");
+  _writeBuffer(0x10, xs8, xe8, y, y + h); // the displayed image, old data of the next partial update
+  IO.writeCommandTransaction(0x92); // partial out
+  _powerOff();
+}
+
+void GxGDEW042T2::powerDown(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_hibernating) _sleep();
 }
 
 void  GxGDEW042T2::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  if (color)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
-    {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-      drawPixel(x1, y1, pixelcolor);
-    }
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  uint8_t bits[GxGDEW042T2_WIDTH / 8 + 1];
+  for (int16_t y1 = py; y1 < py + ph; y1++)
+  {
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, false, true); // bit set is black
+    _copyBits(_buffer + uint32_t(y1) * (GxGDEW042T2_WIDTH / 8), px, pw, bits);
   }
 }
 
 void GxGDEW042T2::_waitWhileBusy(const char* comment)
 {
-  unsigned long start = micros();
+  //unsigned long start = micros();
   while (1)
   { //=0 BUSY
-    if (digitalRead(BSY) == 1) break;
+    if (IO.readBusy(_busy) == 1) break;
     delay(1);
   }
   if (comment)
   {
-    unsigned long elapsed = micros() - start;
+//    unsigned long elapsed = micros() - start;
 //    Serial.print(comment);
 //    Serial.print(" : ");
 //    Serial.println(elapsed);
   }
 }
 
+bool GxGDEW042T2::_startUpdate(void)
+{
+  uint16_t ys, ye;
+  if (!_changedRows(ys, ye)) return false;
+  // a partial update needs the displayed image in the controller RAM
+  _partial_update = (_profile == PARTIAL) && !_hibernating;
+  _powerOn();
+  if (_partial_update)
+  {
+    _writeLUT(PARTIAL);
+    IO.writeCommandTransaction(0x91); // partial in
+    _setPartialWindow(0, ys, GxGDEW042T2_WIDTH, ye - ys);
+    _writeBuffer(0x13, 0, GxGDEW042T2_WIDTH / 8, ys, ye);
+    _update_ys = ys;
+    _update_ye = ye;
+  }
+  else
+  {
+    _writeLUT((_profile == FULL_FAST) ? FULL_FAST : FULL_QUALITY);
+    // old data, not used by the full LUT, for the next partial update
+    _writeBuffer(0x10, 0, GxGDEW042T2_WIDTH / 8, 0, GxGDEW042T2_HEIGHT);
+    _writeBuffer(0x13, 0, GxGDEW042T2_WIDTH / 8, 0, GxGDEW042T2_HEIGHT);
+  }
+  IO.writeCommandTransaction(0x12);      //display refresh
+  return true;
+}
+
+// after the refresh of _startUpdate()
+void GxGDEW042T2::_endUpdate(void)
+{
+  if (_partial_update)
+  {
+    // the displayed image, old data of the next partial update
+    _writeBuffer(0x10, 0, GxGDEW042T2_WIDTH / 8, _update_ys, _update_ye);
+    IO.writeCommandTransaction(0x92); // partial out
+  }
+  _powerOff();
+}
+
+// rows ys .. ye - 1, bytes xs8 .. xe8 - 1 of the buffer to the data of command, bit set is white
+void GxGDEW042T2::_writeBuffer(uint8_t command, uint16_t xs8, uint16_t xe8, uint16_t ys, uint16_t ye)
+{
+  uint8_t row[GxGDEW042T2_WIDTH / 8];
+  IO.writeCommandTransaction(command);
+  for (uint16_t y = ys; y < ye; y++)
+  {
+    const uint8_t* data = _buffer + uint32_t(y) * (GxGDEW042T2_WIDTH / 8);
+    for (uint16_t j = xs8; j < xe8; j++)
+    {
+      row[j - xs8] = ~data[j];
+    }
+    IO.writeDataTransaction(row, xe8 - xs8);
+  }
+}
+
+// full screen to the data of command, filled with white if size is less
+void GxGDEW042T2::_writeBitmap(uint8_t command, const uint8_t* bitmap, uint32_t size)
+{
+  uint8_t row[GxGDEW042T2_WIDTH / 8];
+  if (size > GxGDEW042T2_BUFFER_SIZE) size = GxGDEW042T2_BUFFER_SIZE;
+  IO.writeCommandTransaction(command);
+  IO.writeDataTransaction(bitmap, size);
+  memset(row, 0xFF, sizeof(row));
+  for (uint32_t i = size; i < GxGDEW042T2_BUFFER_SIZE; i += sizeof(row))
+  {
+    uint32_t n = GxGDEW042T2_BUFFER_SIZE - i;
+    IO.writeDataTransaction(row, (n < sizeof(row)) ? n : sizeof(row));
+  }
+}
+
+// x and w multiple of 8
+void GxGDEW042T2::_setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  uint16_t xe = x + w - 1;
+  uint16_t ye = y + h - 1;
+  IO.writeCommandTransaction(0x90); // partial window
+  IO.writeDataTransaction(x / 256);
+  IO.writeDataTransaction(x % 256);
+  IO.writeDataTransaction(xe / 256);
+  IO.writeDataTransaction(xe % 256);
+  IO.writeDataTransaction(y / 256);
+  IO.writeDataTransaction(y % 256);
+  IO.writeDataTransaction(ye / 256);
+  IO.writeDataTransaction(ye % 256);
+  IO.writeDataTransaction(0x01); // gates scan inside and outside of the partial window
+}
+
+bool GxGDEW042T2::_changedRows(uint16_t& ys, uint16_t& ye)
+{
+  ys = _row_hashes_valid ? GxGDEW042T2_HEIGHT : 0;
+  ye = _row_hashes_valid ? 0 : GxGDEW042T2_HEIGHT;
+  for (uint16_t y = 0; y < GxGDEW042T2_HEIGHT; y++)
+  {
+    uint32_t hash = _hash32(_buffer + uint32_t(y) * (GxGDEW042T2_WIDTH / 8), GxGDEW042T2_WIDTH / 8);
+    if (hash != _row_hash[y])
+    {
+      _row_hash[y] = hash;
+      if (y < ys) ys = y;
+      if (y >= ye) ye = y + 1;
+    }
+  }
+  _row_hashes_valid = true;
+  return (ys < ye);
+}
+
 void GxGDEW042T2::_wakeUp(void)
 {
   digitalWrite(_rst, 0);
@@ -234,9 +574,6 @@ void GxGDEW042T2::_wakeUp(void)
   IO.writeDataTransaction(0xbf);
   IO.writeDataTransaction(0x0b);
 
-  IO.writeCommandTransaction(0x30);
-  IO.writeDataTransaction (0x3c);
-
   IO.writeCommandTransaction(0x61);
   IO.writeDataTransaction (0x01);
   IO.writeDataTransaction (0x90);
@@ -248,7 +585,23 @@ void GxGDEW042T2::_wakeUp(void)
 
   IO.writeCommandTransaction(0X50);
   IO.writeDataTransaction(0x97);
-  _writeLUT();
+}
+
+void GxGDEW042T2::_powerOn(void)
+{
+  if (_hibernating) _wakeUp(); // reset, init and power on
+  else
+  {
+    IO.writeCommandTransaction(0x04);
+    _waitWhileBusy("Power On");
+  }
+  _hibernating = false;
+}
+
+void GxGDEW042T2::_powerOff(void)
+{
+  IO.writeCommandTransaction(0x02); // controller RAM and registers are kept
+  _waitWhileBusy("Power Off");
 }
 
 void GxGDEW042T2::_sleep(void)
@@ -270,62 +623,42 @@ void GxGDEW042T2::_sleep(void)
   _waitWhileBusy("Power Off");
   IO.writeCommandTransaction(0X07);
   IO.writeDataTransaction(0xA5);
+  _hibernating = true; // controller RAM lost
 }
 
-void GxGDEW042T2::_writeLUT(void)
+void GxGDEW042T2::_writeLUT(RefreshProfile profile)
 {
-  uint16_t count;
-  IO.writeCommandTransaction(0x20);
-  for (count = 0; count < 44; count++)
+  IO.writeCommandTransaction(0x30); // PLL, frame rate
+  IO.writeDataTransaction(_pllSetting(_frameRate(profile)));
+  const uint8_t* const* luts = (profile == PARTIAL) ? luts_partial : (profile == FULL_FAST) ? luts_fast : luts_quality;
+  for (uint8_t i = 0; i < 5; i++)
   {
-    IO.writeDataTransaction(lut_vcom0[count]);
-  }
-
-  IO.writeCommandTransaction(0x21);
-  for (count = 0; count < 42; count++)
-  {
-    IO.writeDataTransaction(lut_ww[count]);
-  }
-
-  IO.writeCommandTransaction(0x22);
-  for (count = 0; count < 42; count++)
-  {
-    IO.writeDataTransaction(lut_bw[count]);
-  }
-
-  IO.writeCommandTransaction(0x23);
-  for (count = 0; count < 42; count++)
-  {
-    IO.writeDataTransaction(lut_wb[count]);
-  }
-
-  IO.writeCommandTransaction(0x24);
-  for (count = 0; count < 42; count++)
-  {
-    IO.writeDataTransaction(lut_bb[count]);
+    IO.writeCommandTransaction(0x20 + i); // vcom0, ww, bw, wb, bb
+    IO.writeDataTransaction(luts[i], (i == 0) ? 44 : 42);
   }
 }
 
 void GxGDEW042T2::greyTest() // what do the 2 channels provide ?
 {
-  _wakeUp();
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // displayed image replaced
+  _powerOn();
+  _writeLUT(FULL_QUALITY);
+  uint8_t row[GxGDEW042T2_WIDTH / 8];
   IO.writeCommandTransaction(0x10);
+  for (uint16_t x8 = 0; x8 < GxGDEW042T2_WIDTH / 8; x8++)
+  {
+    row[x8] = (x8 < GxGDEW042T2_WIDTH / 8 / 2) ? 0xFF : 0x00;
+  }
   for (uint16_t y = 0; y < GxGDEW042T2_HEIGHT; y++)
   {
-    for (uint16_t x8 = 0; x8 < GxGDEW042T2_WIDTH / 8; x8++)
-    {
-      uint8_t data = (x8 < GxGDEW042T2_WIDTH / 8 / 2) ? 0xFF : 0x00;
-      IO.writeDataTransaction(data);
-    }
+    IO.writeDataTransaction(row, sizeof(row));
   }
   IO.writeCommandTransaction(0x13);
   for (uint16_t y = 0; y < GxGDEW042T2_HEIGHT; y++)
   {
-    for (uint16_t x8 = 0; x8 < GxGDEW042T2_WIDTH / 8; x8++)
-    {
-      uint8_t data = (y <  GxGDEW042T2_HEIGHT / 2) ? 0xFF : 0x00;
-      IO.writeDataTransaction(data);
-    }
+    memset(row, (y <  GxGDEW042T2_HEIGHT / 2) ? 0xFF : 0x00, sizeof(row));
+    IO.writeDataTransaction(row, sizeof(row));
   }
   IO.writeCommandTransaction(0x12);      //display refresh
   _waitWhileBusy("greyTest display refresh");
@@ -57,6 +57,11 @@
 
 #define GxGDEW042T2_BUFFER_SIZE GxGDEW042T2_WIDTH * GxGDEW042T2_HEIGHT / 8
 
+#if !defined(GxGDEW042T2_WARM_TEMPERATURE)
+#define GxGDEW042T2_WARM_TEMPERATURE 35 // degree Celsius, setTemperature() at or above runs the waveforms one frame rate step faster
+#endif
+// define GxGDEW042T2_WARM_FRAME_RATE to enable the faster frame rate for a warm panel, untested on the panel
+
 class GxGDEW042T2 : public GxEPD
 {
   public:
@@ -64,23 +69,64 @@ class GxGDEW042T2 : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // 0x0 black, >0x0 white, to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
+    // start update, return without waiting for refresh, isBusy() completes it
+    void updateAsync(void);
+    bool isBusy(void);
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t *bitmap, uint32_t size);
-    // to buffer, may be cropped, drawPixel() used, update needed
+    // to buffer, may be cropped, update needed
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+    // to full screen by partial update, only changed pixels are driven, filled with white if size is less, no update needed
+    void drawBitmap(const uint8_t *bitmap, uint32_t size, bool using_partial_update);
+    // partial update of the window, in rotated coordinates (the SSD1607 class display classes take physical ones),
+    // only changed pixels are driven, with a short waveform;
+    // a full update from time to time removes the ghosting of partial updates
+    void updateWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    // controller to deep sleep, the updates keep it powered off only, for the displayed image in its RAM;
+    // the next update is a full update
+    void powerDown(void);
+    // profile of update(), updateAsync() and drawBitmap(bitmap, size) : FULL_QUALITY (default), FULL_FAST (each phase once
+    // at 100Hz, some ghosting), PARTIAL (update() of the changed rows by partial update, full update after init() or powerDown())
+    void setRefreshProfile(RefreshProfile profile);
+    // expected duration of the refresh of profile in ms, from the frames of its LUT, without data transfer
+    uint32_t refreshTime(RefreshProfile profile);
+    // panel temperature in degree Celsius from the application, e.g. of a sensor near the panel, no read-back without MISO;
+    // at or above GxGDEW042T2_WARM_TEMPERATURE the waveforms of the profiles run at the next higher frame rate, true if so;
+    // only if GxGDEW042T2_WARM_FRAME_RATE is defined, untested on the panel; the default assumes a cold panel
+    bool setTemperature(int8_t temperature);
     // GxGDEW042T2 may have 2 channels, commands 0x10 and 0x13, but no grey levels
     void greyTest(); // what do the 2 channels provide ? bw only
   private:
-    void _writeLUT();
+    void _writeLUT(RefreshProfile profile);
     void _wakeUp();
     void _sleep(void);
+    void _powerOn(void);
+    void _powerOff(void);
+    void _writeBuffer(uint8_t command, uint16_t xs8, uint16_t xe8, uint16_t ys, uint16_t ye);
+    void _writeBitmap(uint8_t command, const uint8_t* bitmap, uint32_t size);
+    void _setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
     void _waitWhileBusy(const char* comment = 0);
+    uint16_t _frameRate(RefreshProfile profile); // Hz
+    bool _startUpdate(void); // false if nothing changed
+    void _endUpdate(void);
+    bool _changedRows(uint16_t& ys, uint16_t& ye); // rows ys .. ye - 1 changed since last update(), updates row hashes
   private:
     uint8_t _buffer[GxGDEW042T2_BUFFER_SIZE];
     GxIO& IO;
     uint8_t _rst;
     uint8_t _busy;
+    bool _row_hashes_valid; // _row_hash[] matches the displayed image
+    bool _update_pending; // updateAsync() refresh not yet completed
+    bool _hibernating; // controller in deep sleep or not initialized, else its old data RAM (0x10) is the displayed image
+    RefreshProfile _profile;
+    bool _warm; // setTemperature() at or above GxGDEW042T2_WARM_TEMPERATURE
+    bool _partial_update; // the update in progress is a partial update of rows _update_ys .. _update_ye - 1
+    uint16_t _update_ys, _update_ye;
+    uint32_t _row_hash[GxGDEW042T2_HEIGHT]; // of rows last sent by update()
 };
 
 #define GxEPD_Class GxGDEW042T2
@@ -29,10 +29,12 @@
 */
 
 #include "GxGDEW075T8.h"
+#include "../GxEPD_ExpandTable.h"
 
 GxGDEW075T8::GxGDEW075T8(GxIO& io, uint8_t rst, uint8_t busy)
   : GxEPD(GxGDEW075T8_WIDTH, GxGDEW075T8_HEIGHT),
-    IO(io), _rst(rst), _busy(busy)
+    IO(io), _rst(rst), _busy(busy),
+    _row_hashes_valid(false), _update_pending(false), _profile(FULL_QUALITY), _warm(false), _partial_update(false)
 {
 }
 
@@ -91,59 +93,126 @@ void GxGDEW075T8::fillScreen(uint16_t color)
   }
 }
 
+void GxGDEW075T8::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDEW075T8::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDEW075T8::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  for (int16_t y1 = y; y1 < y + h; y1++)
+  {
+    _fillBits(_buffer + uint32_t(y1) * (GxGDEW075T8_WIDTH / 8), x, w, !color);
+  }
+}
+
 void GxGDEW075T8::update(void)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_startUpdate()) return; // panel shows the buffer content already
+  _waitWhileBusy();
+  _endUpdate();
+}
+
+void GxGDEW075T8::updateAsync(void)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (_startUpdate()) _update_pending = true;
+  else _updateDone();
+}
+
+bool GxGDEW075T8::isBusy(void)
+{
+  if (!_update_pending) return false;
+  if (IO.readBusy(_busy) == 0) return true; // =0 BUSY
+  _update_pending = false;
+  _endUpdate();
+  _updateDone();
+  return false;
+}
+
+void GxGDEW075T8::setRefreshProfile(RefreshProfile profile)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _profile = profile;
+}
+
+uint32_t GxGDEW075T8::refreshTime(RefreshProfile profile)
+{
+  // nominal, the waveform is in the OTP of the controller, 4s at 50Hz
+  return uint32_t(4000) * 50 / _frameRate(profile);
+}
+
+bool GxGDEW075T8::setTemperature(int8_t temperature)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _warm = (temperature >= GxGDEW075T8_WARM_TEMPERATURE);
+#if defined(GxGDEW075T8_WARM_FRAME_RATE)
+  return _warm;
+#else
+  return false;
+#endif
+}
+
+uint16_t GxGDEW075T8::_frameRate(RefreshProfile profile)
+{
+  uint16_t hz = (profile == FULL_FAST) ? 100 : 50;
+#if defined(GxGDEW075T8_WARM_FRAME_RATE)
+  if (_warm) hz += 50; // the panel responds faster when warm, untested
+#endif
+  return hz;
+}
+
+void GxGDEW075T8::updateWindow(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  if (!_rotateRect(x, y, w, h)) return;
+  _row_hashes_valid = false; // rows updated in part
+  uint16_t xs8 = x / 8, xe8 = (x + w + 7) / 8; // bytes of the window in a buffer row
   _wakeUp(true);
+  IO.writeCommandTransaction(0x91);     //PARTIAL IN
+  _setPartialWindow(xs8 * 8, y, (xe8 - xs8) * 8, h);
   IO.writeCommandTransaction(0x10);
-  for (uint32_t i = 0; i < GxGDEW075T8_BUFFER_SIZE; i++)
-  {
-#if defined(ESP8266)
-    // (10000 * 8bit * (8bits/bit + gap)/ 4MHz = ~ 200ms
-    // (31000 * 8bit * (8bits/bit + gap)/ 4MHz = ~ 600ms is safe
-    // if ((i % 10000) == 0) yield(); // avoid watchdog reset
-#endif
-    uint8_t t1 = _buffer[i];
-    for (uint8_t j = 0; j < 8; j++)
-    {
-      uint8_t t2 = t1 & 0x80 ? 0x00 : 0x03;
-      t2 <<= 4;
-      t1 <<= 1;
-      j++;
-      t2 |= t1 & 0x80 ? 0x00 : 0x03;
-      t1 <<= 1;
-      IO.writeDataTransaction(t2);
-    }
-  }
-  //IO.writeCommandTransaction(0x04);        //POWER ON
-  //_waitWhileBusy();
-  IO.writeCommandTransaction(0x12);      //display refresh
+  _writeExpanded(_buffer, GxGDEW075T8_BUFFER_SIZE, xs8, xe8, y, y + h);
+  IO.writeCommandTransaction(0x12);      //display refresh, of the partial window only
   _waitWhileBusy();
+  IO.writeCommandTransaction(0x92);     //PARTIAL OUT
   _sleep();
 }
 
 void GxGDEW075T8::drawBitmap(const uint8_t *bitmap, uint32_t size)
 {
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // displayed image replaced
   Serial.print("drawBitmap "); Serial.println(size);
   _wakeUp(true);
   IO.writeCommandTransaction(0x10);
-  for (uint32_t i = 0; i < GxGDEW075T8_BUFFER_SIZE; i++)
+  _writeExpanded(bitmap, size);
+  IO.writeCommandTransaction(0x12);      //display refresh
+  _waitWhileBusy();
+  _sleep();
+}
+
+void GxGDEW075T8::drawPicture(const uint8_t* picture, uint32_t size)
+{
+  while (isBusy()) delay(1); // complete a pending updateAsync()
+  _row_hashes_valid = false; // displayed image replaced
+  uint8_t chunk[GxGDEW075T8_CHUNK_SIZE];
+  if (size > GxGDEW075T8_PICTURE_SIZE) size = GxGDEW075T8_PICTURE_SIZE;
+  _wakeUp(true);
+  IO.writeCommandTransaction(0x10);
+  IO.writeDataTransaction(picture, size);
+  memset(chunk, 0x33, sizeof(chunk));
+  for (uint32_t i = size; i < GxGDEW075T8_PICTURE_SIZE; i += sizeof(chunk))
   {
-#if defined(ESP8266)
-    // (10000 * 8bit * (8bits/bit + gap)/ 4MHz = ~ 200ms
-    // (31000 * 8bit * (8bits/bit + gap)/ 4MHz = ~ 600ms is safe
-    // if ((i % 10000) == 0) yield(); // avoid watchdog reset
-#endif
-    uint8_t t1 = i < size ? bitmap[i] : 0;
-    for (uint8_t j = 0; j < 8; j++)
-    {
-      uint8_t t2 = t1 & 0x80 ? 0x00 : 0x03;
-      t2 <<= 4;
-      t1 <<= 1;
-      j++;
-      t2 |= t1 & 0x80 ? 0x00 : 0x03;
-      t1 <<= 1;
-      IO.writeDataTransaction(t2);
-    }
+    uint32_t n = GxGDEW075T8_PICTURE_SIZE - i;
+    IO.writeDataTransaction(chunk, (n < sizeof(chunk)) ? n : sizeof(chunk));
   }
   IO.writeCommandTransaction(0x12);      //display refresh
   _waitWhileBusy();
@@ -152,23 +221,71 @@ void GxGDEW075T8::drawBitmap(const uint8_t *bitmap, uint32_t size)
 
 void  GxGDEW075T8::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is color, bit clear is white
+  if ((w <= 0) || (h <= 0)) return;
+  if (color)
+  {
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  uint8_t bits[GxGDEW075T8_WIDTH / 8 + 1];
+  for (int16_t y1 = py; y1 < py + ph; y1++)
+  {
+    _bitmapRow(bits, px % 8, bitmap, x, y, w, px, y1, pw, false, false);
+    _copyBits(_buffer + uint32_t(y1) * (GxGDEW075T8_WIDTH / 8), px, pw, bits);
+  }
+}
+
+void GxGDEW075T8::_writeExpanded(const uint8_t* bitmap, uint32_t size, uint16_t xs8, uint16_t xe8, uint16_t ys, uint16_t ye)
+{
+  // 1 bit per pixel to 4 bits per pixel by table, bytes xs8 .. xe8 - 1 of rows ys .. ye - 1, 0 after size,
+  // streamed in data blocks of the chunk size, across rows
+  uint8_t chunk[GxGDEW075T8_CHUNK_SIZE / 4 * 4];
+  uint16_t n = 0;
+  for (uint32_t i = uint32_t(ys) * (GxGDEW075T8_WIDTH / 8); i < uint32_t(ye) * (GxGDEW075T8_WIDTH / 8); i += GxGDEW075T8_WIDTH / 8)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
+    for (uint16_t x8 = xs8; x8 < xe8; x8++)
     {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? color : GxEPD_WHITE;
-      drawPixel(x1, y1, pixelcolor);
+      uint32_t data = GxEPD_expand4((i + x8) < size ? bitmap[i + x8] : 0);
+      chunk[n++] = data >> 24;
+      chunk[n++] = data >> 16;
+      chunk[n++] = data >> 8;
+      chunk[n++] = data;
+      if (n == sizeof(chunk))
+      {
+        IO.writeDataTransaction(chunk, n);
+        n = 0;
+      }
     }
   }
+  if (n > 0) IO.writeDataTransaction(chunk, n);
+}
+
+// x and w multiple of 8
+void GxGDEW075T8::_setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  uint16_t xe = x + w - 1;
+  uint16_t ye = y + h - 1;
+  IO.writeCommandTransaction(0x90);     //PARTIAL WINDOW
+  IO.writeDataTransaction(x / 256);
+  IO.writeDataTransaction(x % 256);
+  IO.writeDataTransaction(xe / 256);
+  IO.writeDataTransaction(xe % 256);
+  IO.writeDataTransaction(y / 256);
+  IO.writeDataTransaction(y % 256);
+  IO.writeDataTransaction(ye / 256);
+  IO.writeDataTransaction(ye % 256);
+  IO.writeDataTransaction(0x01);        //gates scan inside and outside of the partial window
 }
 
 void GxGDEW075T8::_waitWhileBusy(const char* comment)
 {
-  unsigned long start = micros();
+  //unsigned long start = micros();
   while (1)
   { //=0 BUSY
-    if (digitalRead(BSY) == 1) break;
+    if (IO.readBusy(_busy) == 1) break;
     delay(1);
   }
   if (comment)
@@ -180,6 +297,55 @@ void GxGDEW075T8::_waitWhileBusy(const char* comment)
   }
 }
 
+bool GxGDEW075T8::_startUpdate(void)
+{
+  uint16_t ys, ye;
+  if (!_changedRows(ys, ye)) return false;
+  _partial_update = (_profile == PARTIAL);
+  _wakeUp(true);
+  if (_partial_update)
+  {
+    IO.writeCommandTransaction(0x91);     //PARTIAL IN
+    _setPartialWindow(0, ys, GxGDEW075T8_WIDTH, ye - ys);
+  }
+  else
+  {
+    ys = 0;
+    ye = GxGDEW075T8_HEIGHT;
+  }
+  IO.writeCommandTransaction(0x10);
+  _writeExpanded(_buffer, GxGDEW075T8_BUFFER_SIZE, 0, GxGDEW075T8_WIDTH / 8, ys, ye);
+  //IO.writeCommandTransaction(0x04);        //POWER ON
+  //_waitWhileBusy();
+  IO.writeCommandTransaction(0x12);      //display refresh
+  return true;
+}
+
+// after the refresh of _startUpdate()
+void GxGDEW075T8::_endUpdate(void)
+{
+  if (_partial_update) IO.writeCommandTransaction(0x92);     //PARTIAL OUT
+  _sleep();
+}
+
+bool GxGDEW075T8::_changedRows(uint16_t& ys, uint16_t& ye)
+{
+  ys = _row_hashes_valid ? GxGDEW075T8_HEIGHT : 0;
+  ye = _row_hashes_valid ? 0 : GxGDEW075T8_HEIGHT;
+  for (uint16_t y = 0; y < GxGDEW075T8_HEIGHT; y++)
+  {
+    uint32_t hash = _hash32(_buffer + uint32_t(y) * (GxGDEW075T8_WIDTH / 8), GxGDEW075T8_WIDTH / 8);
+    if (hash != _row_hash[y])
+    {
+      _row_hash[y] = hash;
+      if (y < ys) ys = y;
+      if (y >= ye) ye = y + 1;
+    }
+  }
+  _row_hashes_valid = true;
+  return (ys < ye);
+}
+
 void GxGDEW075T8::_wakeUp(bool partial)
 {
   digitalWrite(_rst, 0);
@@ -213,10 +379,10 @@ void GxGDEW075T8::_wakeUp(bool partial)
   IO.writeDataTransaction (0x28);
 
   IO.writeCommandTransaction(0x30);     //PLL setting
-  IO.writeDataTransaction (0x3c);
+  IO.writeDataTransaction (_pllSetting(_frameRate(_profile)));
 
   IO.writeCommandTransaction(0X41);     //TEMPERATURE SETTING
-  IO.writeDataTransaction(0x00);
+  IO.writeDataTransaction(0x00);        //internal sensor, selects the waveform of the OTP
 
   IO.writeCommandTransaction(0X50);     //VCOM AND DATA INTERVAL SETTING
   IO.writeDataTransaction(0x77);
@@ -250,7 +416,7 @@ void GxGDEW075T8::_sleep(void)
   /**********************************flash sleep**********************************/
 
   IO.writeCommandTransaction(0x02);     // POWER OFF
-  while (!digitalRead(BSY));
+  while (!IO.readBusy(_busy));
 
   IO.writeCommandTransaction(0x07);     // DEEP SLEEP
   IO.writeDataTransaction(0xa5);
@@ -57,6 +57,16 @@
 
 #define GxGDEW075T8_BUFFER_SIZE GxGDEW075T8_WIDTH * GxGDEW075T8_HEIGHT / 8
 
+#if !defined(GxGDEW075T8_WARM_TEMPERATURE)
+#define GxGDEW075T8_WARM_TEMPERATURE 35 // degree Celsius, setTemperature() at or above runs the waveforms one frame rate step faster
+#endif
+// define GxGDEW075T8_WARM_FRAME_RATE to enable the faster frame rate for a warm panel, untested on the panel
+#define GxGDEW075T8_PICTURE_SIZE (uint32_t(GxGDEW075T8_WIDTH) * GxGDEW075T8_HEIGHT / 2) // 4 bits per pixel
+
+#if !defined(GxGDEW075T8_CHUNK_SIZE)
+#define GxGDEW075T8_CHUNK_SIZE 1024 // bytes of 4 bpp data per data transaction, on the stack
+#endif
+
 class GxGDEW075T8 : public GxEPD
 {
   public:
@@ -64,14 +74,44 @@ class GxGDEW075T8 : public GxEPD
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void init(void);
     void fillScreen(uint16_t color); // 0x0 black, >0x0 white, to buffer
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color); // to buffer
     void update(void);
+    // start update, return without waiting for refresh, isBusy() completes it
+    void updateAsync(void);
+    bool isBusy(void);
     // to full screen, filled with white if size is less, no update needed
     void drawBitmap(const uint8_t *bitmap, uint32_t size);
-    // to buffer, may be cropped, drawPixel() used, update needed
+    // to buffer, may be cropped, update needed
     void  drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+    // to full screen, 4 bits per pixel in the format of the controller, 0x0 black, 0x3 white, 2 pixels per byte, MSB first,
+    // sent as is, filled with white if size is less, no update needed
+    void drawPicture(const uint8_t* picture, uint32_t size);
+    // partial update of the window, in rotated coordinates (the SSD1607 class display classes take physical ones);
+    // only the window is sent and refreshed, with the full waveform
+    void updateWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    // profile of the refreshes : FULL_QUALITY (default) at 50Hz, FULL_FAST at 100Hz, PARTIAL update() of the changed rows
+    // by the partial window at 50Hz; the waveform is in the OTP of the controller, the same for all profiles;
+    // FULL_FAST and PARTIAL are untested on the panel
+    void setRefreshProfile(RefreshProfile profile);
+    // estimated duration of the refresh of profile in ms, not measured: 4000ms of the OTP waveform at 50Hz
+    // scaled by the frame rate, without data transfer
+    uint32_t refreshTime(RefreshProfile profile);
+    // panel temperature in degree Celsius from the application, e.g. of a sensor near the panel, no read-back without MISO;
+    // at or above GxGDEW075T8_WARM_TEMPERATURE the waveform runs at the next higher frame rate, true if so;
+    // only if GxGDEW075T8_WARM_FRAME_RATE is defined, untested on the panel; the default assumes a cold panel
+    bool setTemperature(int8_t temperature);
 
   private:
+    void _writeExpanded(const uint8_t* bitmap, uint32_t size, uint16_t xs8 = 0, uint16_t xe8 = GxGDEW075T8_WIDTH / 8,
+                        uint16_t ys = 0, uint16_t ye = GxGDEW075T8_HEIGHT);
+    void _setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
     void _waitWhileBusy(const char* comment=0);
+    uint16_t _frameRate(RefreshProfile profile); // Hz
+    bool _startUpdate(void); // false if nothing changed
+    void _endUpdate(void);
+    bool _changedRows(uint16_t& ys, uint16_t& ye); // rows ys .. ye - 1 changed since last update(), updates row hashes
     void _wakeUp(bool partial);
     void _sleep();
 
@@ -80,6 +120,12 @@ class GxGDEW075T8 : public GxEPD
     GxIO& IO;
     uint8_t _rst;
     uint8_t _busy;
+    bool _row_hashes_valid; // _row_hash[] matches the displayed image
+    bool _update_pending; // updateAsync() refresh not yet completed
+    RefreshProfile _profile;
+    bool _warm; // setTemperature() at or above GxGDEW075T8_WARM_TEMPERATURE
+    bool _partial_update; // the update in progress is a partial update
+    uint32_t _row_hash[GxGDEW075T8_HEIGHT]; // of rows last sent by update()
 };
 
 #define GxEPD_Class GxGDEW075T8
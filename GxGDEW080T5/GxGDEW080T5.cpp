@@ -21,11 +21,22 @@
 
 #include "BitmapExamples.h"
 
+// the built-in waveform, expanded at compile time, in flash
+static constexpr GxEPD_WaveTable<GxGDEW080T5_FRAME_BEGIN_SIZE> wave_begin_table_80 = GxEPD_WaveTables::waveTable(wave_begin_80, false);
+static constexpr GxEPD_WaveTable<GxGDEW080T5_FRAME_END_SIZE> wave_end_table_80 = GxEPD_WaveTables::waveTable(wave_end_80, false);
+static constexpr GxEPD_TransitionTable<GxGDEW080T5_FRAME_BEGIN_SIZE - 1 + GxGDEW080T5_FRAME_END_SIZE - 3> transition_table_80 =
+  GxEPD_WaveTables::transitionTable(wave_begin_80, wave_end_80, false);
+static constexpr GxEPD_TransitionTable<1> fast_table_80 = GxEPD_WaveTables::fastTable(false);
+
 GxGDEW080T5::GxGDEW080T5(GxIO_DESTM32L& io)
-  : GxEPD(GxGDEW080T5_WIDTH, GxGDEW080T5_HEIGHT), IO(io),
+  : GxEPD(GxGDEW080T5_WIDTH, GxGDEW080T5_HEIGHT),
     p_active_buffer(&FMSC_SRAM->epd_sram_buffer1),
-    p_erase_buffer(&FMSC_SRAM->epd_sram_buffer2)
+    p_erase_buffer(&FMSC_SRAM->epd_sram_buffer2),
+    _grey_color(GxEPD_BLACK), _grey_level(0), _erase_buffer_valid(false),
+    _waveforms(0), _waveform_set(-1), _waveform_tables(0), _temperature(25),
+    _region_count(0), IO(io)
 {
+  use_builtin_waveform();
 }
 
 template <typename T> static inline void
@@ -36,6 +47,8 @@ swap(T& a, T& b)
   b = t;
 }
 
+#define NO_ROW 0xFFFFFFFF // for build_row()
+
 void GxGDEW080T5::drawPixel(int16_t x, int16_t y, uint16_t color)
 {
   if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
@@ -57,77 +70,299 @@ void GxGDEW080T5::drawPixel(int16_t x, int16_t y, uint16_t color)
       break;
   }
   uint32_t i = x / 4 + y * GxGDEW080T5_WIDTH / 4;
-  (*p_active_buffer)[i] = ((*p_active_buffer)[i] & (0xFF ^ (3 << 2 * (3 - x % 4))));
-  if (color == GxEPD_BLACK) return;
-  else if (color == GxEPD_WHITE) (*p_active_buffer)[i] = ((*p_active_buffer)[i] | (3 << 2 * (3 - x % 4)));
-  else if (color == GxEPD_DARKGREY) (*p_active_buffer)[i] = ((*p_active_buffer)[i] | (1 << 2 * (3 - x % 4)));
-  else if (color == GxEPD_LIGHTGREY) (*p_active_buffer)[i] = ((*p_active_buffer)[i] | (2 << 2 * (3 - x % 4)));
+  uint8_t shift = 2 * (3 - x % 4);
+  (*p_active_buffer)[i] = ((*p_active_buffer)[i] & (0xFF ^ (3 << shift))) | (_greyLevel(color) << shift);
+}
+
+void GxGDEW080T5::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  fillRect(x, y, 1, h, color);
+}
+
+void GxGDEW080T5::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void GxGDEW080T5::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_rotateRect(x, y, w, h)) return;
+  uint8_t grey = _greyLevel(color);
+  for (int16_t y1 = y; y1 < y + h; y1++)
+  {
+    _fillBits2(*p_active_buffer + uint32_t(y1) * GxGDEW080T5_ROW_BUFFER_SIZE, x, w, grey);
+  }
+}
+
+uint8_t GxGDEW080T5::_greyLevel(uint16_t color)
+{
+  if (color == _grey_color) return _grey_level; // same color as last time, mostly
+  _grey_color = color;
+  if (color == GxEPD_BLACK) _grey_level = 0;
+  else if (color == GxEPD_WHITE) _grey_level = 3;
+  else if (color == GxEPD_DARKGREY) _grey_level = 1;
+  else if (color == GxEPD_LIGHTGREY) _grey_level = 2;
   else
   {
-    uint16_t brightness = ((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) & (color & 0x001F);
-    if (brightness < 3 * 128 / 2) return; // < 1/2 of 3 * GxEPD_DARKGREY, below middle between black and dark grey
-    else if (brightness < 3 * 256 / 2) (*p_active_buffer)[i] = ((*p_active_buffer)[i] | (1 << 2 * (3 - x % 4))); // below middle
-    else if (brightness < 3 * 192 / 2) (*p_active_buffer)[i] = ((*p_active_buffer)[i] | (2 << 2 * (3 - x % 4))); // below middle between light grey and white
-    else (*p_active_buffer)[i] = ((*p_active_buffer)[i] | (3 << 2 * (3 - x % 4))); // above middle between light grey and white
+    uint16_t brightness = _brightness(color);
+    if (brightness < 3 * 128 / 2) _grey_level = 0; // < 1/2 of 3 * GxEPD_DARKGREY, below middle between black and dark grey
+    else if (brightness < 3 * (128 + 192) / 2) _grey_level = 1; // below middle between dark grey and light grey
+    else if (brightness < 3 * (192 + 255) / 2) _grey_level = 2; // below middle between light grey and white
+    else _grey_level = 3; // above middle between light grey and white
   }
+  return _grey_level;
 }
 
 void GxGDEW080T5::init(void)
 {
   IO.init(PB15);
-  init_wave_table();
 }
 
 void GxGDEW080T5::fillScreen(uint16_t color)
 {
-  uint8_t data;
-  if (color == GxEPD_BLACK) data = 0x00;
-  else if (color == GxEPD_WHITE) data = 0xFF;
-  else if (color == GxEPD_DARKGREY) data = 0x55;
-  else if (color == GxEPD_LIGHTGREY) data = 0xAA;
+  memset(*p_active_buffer, _greyLevel(color) * 0x55, sizeof(epd_buffer_type));
+}
+
+void GxGDEW080T5::update()
+{
+  while (isBusy()); // complete the regions in flight
+  if (_erase_buffer_valid) drawTransition(*p_erase_buffer, *p_active_buffer);
   else
   {
-    uint16_t brightness = ((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) & (color & 0x001F);
-    if (brightness < 3 * 128 / 2)  data = 0x00; // < 1/2 of 3 * GxEPD_DARKGREY, below middle between black and dark grey
-    else if (brightness < 3 * 256 / 2)  data = 0x55; // below middle
-    else if (brightness < 3 * 192 / 2)  data = 0xAA; // below middle between light grey and white
-    else data = 0xFF; // above middle between light grey and white
+    eraseBitmap(*p_erase_buffer, sizeof(epd_buffer_type));
+    drawBitmap(*p_active_buffer, sizeof(epd_buffer_type));
   }
-  for (uint32_t x = 0; x < GxGDEW080T5_BUFFER_SIZE; x++)
+  swap(p_erase_buffer, p_active_buffer);
+  _erase_buffer_valid = true;
+}
+
+void GxGDEW080T5::updateFast()
+{
+  while (isBusy()); // complete the regions in flight
+  if (!_erase_buffer_valid)
+  {
+    update();
+    return;
+  }
+  drawTransition(*p_erase_buffer, *p_active_buffer, true);
+  // to what the screen shows: changed pixels black or white, unchanged pixels kept
+  const uint32_t* o = (const uint32_t*) *p_erase_buffer;
+  uint32_t* n = (uint32_t*) *p_active_buffer;
+  for (uint32_t i = 0; i < sizeof(epd_buffer_type) / 4; i++)
   {
-    (*p_active_buffer)[x] = data;
+    if (o[i] == n[i]) continue;
+    uint32_t changed = o[i] ^ n[i];
+    changed = (changed | (changed >> 1)) & 0x55555555;
+    changed |= changed << 1; // both bits of each changed pixel
+    uint32_t high = n[i] & 0xAAAAAAAA;
+    n[i] = (n[i] & ~changed) | ((high | (high >> 1)) & changed);
   }
+  swap(p_erase_buffer, p_active_buffer);
 }
 
-void GxGDEW080T5::update()
+void GxGDEW080T5::updateWindow(int16_t x, int16_t y, int16_t w, int16_t h)
 {
-  eraseBitmap(*p_erase_buffer, sizeof(epd_buffer_type));
-  drawBitmap(*p_active_buffer, sizeof(epd_buffer_type));
-  swap(p_erase_buffer, p_active_buffer);
+  while (isBusy()); // complete the regions in flight
+  if (!_erase_buffer_valid)
+  {
+    update();
+    return;
+  }
+  if (_rotateRect(x, y, w, h)) update_window(x, y, w, h);
+}
+
+void GxGDEW080T5::update_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  drawTransition(*p_erase_buffer, *p_active_buffer, false, x, y, w, h);
+  // to what the screen shows: the window updated, changes outside it pending
+  for (uint16_t line = y; line < y + h; line++)
+  {
+    uint8_t* e = *p_erase_buffer + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    const uint8_t* n = *p_active_buffer + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    for (uint16_t i = x / 4; i < (x + w + 3) / 4; i++)
+    {
+      uint8_t mask = _pixelMask2(i, x, w);
+      e[i] = (n[i] & mask) | (e[i] & ~mask);
+    }
+  }
+}
+
+void GxGDEW080T5::updateWindowAsync(int16_t x, int16_t y, int16_t w, int16_t h, bool fast)
+{
+  if (!_erase_buffer_valid)
+  {
+    update();
+    _updateDone();
+    return;
+  }
+  if (!_rotateRect(x, y, w, h)) return;
+  // a free region, overlapping regions completed
+  while ((_region_count == GxGDEW080T5_MAX_REGIONS) || overlaps_region(x, y, w, h)) isBusy();
+  uint16_t bs = x / 4, be = (x + w + 3) / 4; // bytes of the window in a row
+  uint8_t* target = (uint8_t*) malloc(uint32_t(be - bs) * h);
+  if (!target)
+  {
+    // out of memory, synchronous
+    while (isBusy());
+    update_window(x, y, w, h);
+    _updateDone();
+    return;
+  }
+  // transitions present, bit old level * 4 + new level
+  uint16_t present = 0;
+  uint8_t* t = target;
+  for (uint16_t line = y; line < y + h; line++)
+  {
+    const uint8_t* o = *p_erase_buffer + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    const uint8_t* n = *p_active_buffer + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    for (uint16_t i = bs; i < be; i++)
+    {
+      uint8_t mask = _pixelMask2(i, x, w);
+      uint8_t ob = o[i];
+      uint8_t nb = (n[i] & mask) | (ob & ~mask); // pixels outside the window unchanged
+      if (fast)
+      {
+        // to what the screen will show: changed pixels black or white
+        uint8_t changed = ob ^ nb;
+        changed = (changed | (changed >> 1)) & 0x55;
+        changed |= changed << 1; // both bits of each changed pixel
+        uint8_t high = nb & 0xAA;
+        nb = (nb & ~changed) | ((high | (high >> 1)) & changed);
+      }
+      *t++ = nb;
+      for (uint8_t p = 0; p < 4; p++, ob >>= 2, nb >>= 2) present |= 1 << ((ob & 0x3) * 4 + (nb & 0x3));
+    }
+  }
+  present &= ~0x8421; // unchanged pixels
+  if (!present)
+  {
+    free(target);
+    _updateDone();
+    return;
+  }
+  region_type& region = _regions[_region_count++];
+  region.x = x;
+  region.y = y;
+  region.w = w;
+  region.h = h;
+  region.target = target;
+  region.present = present;
+  region.frame = 0;
+  region.fast = fast;
+  if (_region_count == 1)
+  {
+    IO.powerOn();
+    delay(25);
+  }
+  advance_regions();
+}
+
+bool GxGDEW080T5::isBusy(void)
+{
+  if (!_region_count) return false;
+  scan_regions();
+  return (_region_count > 0);
+}
+
+bool GxGDEW080T5::overlaps_region(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  for (uint8_t r = 0; r < _region_count; r++)
+  {
+    const region_type& region = _regions[r];
+    if ((x < region.x + region.w) && (region.x < x + w) && (y < region.y + region.h) && (region.y < y + h)) return true;
+  }
+  return false;
+}
+
+// one frame of each region in flight, with its own table; pixels outside the regions are not driven
+void GxGDEW080T5::scan_regions(void)
+{
+  bool idle = false; // the row sent before is of no drive
+  IO.start_scan();
+  for (uint16_t line = 0; line < GxGDEW080T5_HEIGHT; line++)
+  {
+    const uint8_t* o = *p_erase_buffer + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    bool built = false; // row_buffer is cleared for this row
+    for (uint8_t r = 0; r < _region_count; r++)
+    {
+      const region_type& region = _regions[r];
+      if ((line < region.y) || (line >= region.y + region.h)) continue;
+      if (!built) memset(row_buffer, 0, GxGDEW080T5_ROW_BUFFER_SIZE);
+      built = true;
+      const uint8_t* table = region.fast ? fast_table_80.table[0] : transition_table[region.frame];
+      uint16_t bs = region.x / 4, be = (region.x + region.w + 3) / 4;
+      const uint8_t* n = region.target + uint32_t(line - region.y) * (be - bs);
+      for (uint16_t i = bs; i < be; i++)
+      {
+        uint8_t mask = _pixelMask2(i, region.x, region.w);
+        uint8_t nb = (n[i - bs] & mask) | (o[i] & ~mask); // pixels outside the window unchanged
+        // or, regions may share the byte at an edge
+        row_buffer[i] |= (table[(o[i] & 0xF0) | (nb >> 4)] << 4) | table[uint8_t((o[i] << 4) | (nb & 0x0F))];
+      }
+    }
+    if (!built && !idle) memset(row_buffer, 0, GxGDEW080T5_ROW_BUFFER_SIZE);
+    output_row(idle);
+  }
+  output_row(idle);
+  for (uint8_t r = 0; r < _region_count; r++) _regions[r].frame++;
+  advance_regions();
+}
+
+// each region to its next frame with drive; completed regions to the erase buffer, as the screen shows them
+void GxGDEW080T5::advance_regions(void)
+{
+  for (uint8_t r = 0; r < _region_count;)
+  {
+    region_type& region = _regions[r];
+    uint16_t frames = region.fast ? GxGDEW080T5_FAST_FRAMES : _transition_size;
+    for (; region.frame < frames; region.frame++)
+    {
+      uint16_t frame_mask = region.fast ? fast_table_80.frame_mask[0] : transition_frame_mask[region.frame];
+      if (frame_mask & region.present) break;
+    }
+    if (region.frame < frames)
+    {
+      r++;
+      continue;
+    }
+    const uint8_t* t = region.target;
+    for (uint16_t line = region.y; line < region.y + region.h; line++)
+    {
+      uint8_t* e = *p_erase_buffer + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+      for (uint16_t i = region.x / 4; i < (region.x + region.w + 3) / 4; i++)
+      {
+        uint8_t mask = _pixelMask2(i, region.x, region.w);
+        e[i] = (*t++ & mask) | (e[i] & ~mask);
+      }
+    }
+    free(region.target);
+    _regions[r] = _regions[--_region_count];
+    if (!_region_count)
+    {
+      delay(25);
+      IO.powerOff();
+    }
+    _updateDone();
+  }
 }
 
 void GxGDEW080T5::drawBitmap(const uint8_t *bitmap, uint32_t size)
 {
+  while (isBusy()); // complete the regions in flight
+  _erase_buffer_valid = false; // screen content replaced
   IO.powerOn();
   delay(25);
-  for (uint16_t frame = 0; frame < GxGDEW080T5_FRAME_END_SIZE - 2; frame++)
+  for (uint16_t frame = 0; frame < _frame_end_size - 2; frame++)
   {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDEW080T5_HEIGHT; line++)
     {
-      uint32_t x = line * GxGDEW080T5_ROW_BUFFER_SIZE;
-      uint16_t i = 0;
-      for (; (i < GxGDEW080T5_ROW_BUFFER_SIZE) && (x < size); i++, x++)
-      {
-        row_buffer[i] = wave_end_table[bitmap[x]][frame];
-      }
-      for (; (i < GxGDEW080T5_ROW_BUFFER_SIZE); i++)
-      {
-        row_buffer[i] = wave_end_table[0xFF][frame];
-      }
-      IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+      build_row(wave_end_table[frame], bitmap, uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE, size, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -135,39 +370,99 @@ void GxGDEW080T5::drawBitmap(const uint8_t *bitmap, uint32_t size)
 
 void  GxGDEW080T5::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
 {
-  for (uint16_t x1 = x; x1 < x + w; x1++)
+  // bit set is white, bit clear is color
+  if ((w <= 0) || (h <= 0)) return;
+  uint8_t grey = _greyLevel(color);
+  if (grey == 3)
+  {
+    fillRect(x, y, w, h, GxEPD_WHITE);
+    return;
+  }
+  int16_t px = x, py = y, pw = w, ph = h;
+  if (!_rotateRect(px, py, pw, ph)) return;
+  uint8_t bits[GxGDEW080T5_WIDTH / 8 + 1];
+  for (int16_t y1 = py; y1 < py + ph; y1++)
   {
-    for (uint16_t y1 = y; y1 < y + h; y1++)
+    _bitmapRow(bits, px % 4, bitmap, x, y, w, px, y1, pw, false, false);
+    _copyBits2(*p_active_buffer + uint32_t(y1) * GxGDEW080T5_ROW_BUFFER_SIZE, px, pw, bits, grey);
+  }
+}
+
+void GxGDEW080T5::eraseBitmap(const uint8_t *bitmap, uint32_t size)
+{
+  while (isBusy()); // complete the regions in flight
+  _erase_buffer_valid = false; // screen content replaced
+  IO.powerOn();
+  delay(25);
+  for (uint16_t frame = 0; frame < _frame_begin_size; frame++)
+  {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
+    IO.start_scan();
+    for (uint16_t line = 0; line < GxGDEW080T5_HEIGHT; line++)
     {
-      uint16_t i = x1 / 8 + y1 * w / 8;
-      uint16_t pixelcolor = (bitmap[i] & (0x80 >> x1 % 8)) ? GxEPD_WHITE  : color;
-      drawPixel(x1, y1, pixelcolor);
+      build_row(wave_begin_table[frame], bitmap, uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE, size, prev);
+      output_row(idle);
     }
+    output_row(idle);
   }
+  delay(25);
+  IO.powerOff();
 }
 
-void GxGDEW080T5::eraseBitmap(const uint8_t *bitmap, uint32_t size)
+void GxGDEW080T5::drawTransition(const uint8_t *old_bitmap, const uint8_t *new_bitmap, bool fast, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
+  // transitions present, bit old level * 4 + new level
+  uint16_t present = 0;
+  uint16_t bs = x / 4, be = (x + w + 3) / 4; // bytes of the window in a row
+  for (uint16_t line = y; line < y + h; line++)
+  {
+    const uint8_t* o = old_bitmap + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    const uint8_t* n = new_bitmap + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+    if (memcmp(o + bs, n + bs, be - bs) == 0) continue;
+    for (uint16_t i = bs; i < be; i++)
+    {
+      uint8_t mask = _pixelMask2(i, x, w);
+      uint8_t ob = o[i];
+      uint8_t nb = (n[i] & mask) | (ob & ~mask); // pixels outside the window unchanged
+      for (uint8_t p = 0; p < 4; p++, ob >>= 2, nb >>= 2) present |= 1 << ((ob & 0x3) * 4 + (nb & 0x3));
+    }
+  }
+  present &= ~0x8421; // unchanged pixels
+  if (fast) present &= fast_table_80.frame_mask[0]; // pixels at black or white already
+  if (!present) return;
   IO.powerOn();
   delay(25);
-  for (uint16_t frame = 0; frame < GxGDEW080T5_FRAME_BEGIN_SIZE; frame++)
+  uint16_t frames = fast ? GxGDEW080T5_FAST_FRAMES : _transition_size;
+  for (uint16_t frame = 0; frame < frames; frame++)
   {
+    uint16_t frame_mask = fast ? fast_table_80.frame_mask[0] : transition_frame_mask[frame];
+    if (!(frame_mask & present)) continue; // no pixel driven in this frame
+    const uint8_t* table = fast ? fast_table_80.table[0] : transition_table[frame];
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDEW080T5_HEIGHT; line++)
     {
-      uint32_t x = line * GxGDEW080T5_ROW_BUFFER_SIZE;
-      uint16_t i = 0;
-      for (; (i < GxGDEW080T5_ROW_BUFFER_SIZE) && (x < size); i++, x++)
+      const uint8_t* o = old_bitmap + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+      const uint8_t* n = new_bitmap + uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE;
+      if ((line < y) || (line >= y + h) || (memcmp(o + bs, n + bs, be - bs) == 0))
       {
-        row_buffer[i] = wave_begin_table[bitmap[x]][frame];
+        // unchanged row or outside the window, no drive; skipped after the first one
+        if (!idle) memset(row_buffer, 0, GxGDEW080T5_ROW_BUFFER_SIZE);
+        output_row(idle);
+        continue;
       }
-      for (; (i < GxGDEW080T5_ROW_BUFFER_SIZE); i++)
+      memset(row_buffer, 0, bs);
+      memset(row_buffer + be, 0, GxGDEW080T5_ROW_BUFFER_SIZE - be);
+      for (uint16_t i = bs; i < be; i++)
       {
-        row_buffer[i] = wave_begin_table[0xFF][frame];
+        uint8_t mask = _pixelMask2(i, x, w);
+        uint8_t nb = (n[i] & mask) | (o[i] & ~mask);
+        row_buffer[i] = (table[(o[i] & 0xF0) | (nb >> 4)] << 4) | table[uint8_t((o[i] << 4) | (nb & 0x0F))];
       }
-      IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -177,110 +472,253 @@ void GxGDEW080T5::eraseDisplay()
 {
   eraseBitmap(0, 0);
   fillScreen(GxEPD_WHITE);
+  memset(*p_erase_buffer, 0xFF, sizeof(epd_buffer_type));
+  _erase_buffer_valid = true; // screen is white
+}
+
+// send row_buffer, or only advance the gate driver if row_buffer and the row sent before are of no drive;
+// idle tells if the row sent before is of no drive, false at start of scan
+void GxGDEW080T5::output_row(bool& idle)
+{
+  bool zero = (row_buffer[0] == 0) && (memcmp(row_buffer, row_buffer + 1, GxGDEW080T5_ROW_BUFFER_SIZE - 1) == 0);
+  if (zero && idle) IO.skip_row(GxGDEW080T5_CL_DELAY);
+  else IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+  idle = zero;
+}
+
+// row_buffer from the bitmap row at x through table (one frame of a wave table), white after size;
+// prev is the row built before in this frame, NO_ROW at start of frame; row_buffer is kept for an equal row
+void GxGDEW080T5::build_row(const uint8_t* table, const uint8_t* bitmap, uint32_t x, uint32_t size, uint32_t& prev)
+{
+  if (x + GxGDEW080T5_ROW_BUFFER_SIZE <= size)
+  {
+    const uint8_t* row = bitmap + x;
+    if ((prev < size) && (memcmp(bitmap + prev, row, GxGDEW080T5_ROW_BUFFER_SIZE) == 0))
+    {
+      prev = x;
+      return; // same as previous row, e.g. white space
+    }
+    prev = x;
+    if (uintptr_t(row) % 4 == 0)
+    {
+      // 4 bytes per read, little endian, first byte in lowest bits
+      const uint32_t* src = (const uint32_t*) row;
+      for (uint16_t i = 0; i < GxGDEW080T5_ROW_BUFFER_SIZE; i += 4)
+      {
+        uint32_t data = *src++;
+        row_buffer[i] = table[data & 0xFF];
+        row_buffer[i + 1] = table[(data >> 8) & 0xFF];
+        row_buffer[i + 2] = table[(data >> 16) & 0xFF];
+        row_buffer[i + 3] = table[data >> 24];
+      }
+    }
+    else
+    {
+      for (uint16_t i = 0; i < GxGDEW080T5_ROW_BUFFER_SIZE; i++) row_buffer[i] = table[row[i]];
+    }
+    return;
+  }
+  if ((x >= size) && (prev == size)) return; // white row, same as previous
+  uint16_t i = 0;
+  for (; (i < GxGDEW080T5_ROW_BUFFER_SIZE) && (x + i < size); i++) row_buffer[i] = table[bitmap[x + i]];
+  for (; i < GxGDEW080T5_ROW_BUFFER_SIZE; i++) row_buffer[i] = table[0xFF];
+  prev = (x >= size) ? size : NO_ROW;
+}
+
+void GxGDEW080T5::setWaveforms(GxEPD_Waveforms* waveforms)
+{
+  _waveforms = waveforms;
+  _waveform_set = -2; // force reselect
+  setTemperature(_temperature);
 }
 
-void GxGDEW080T5::init_wave_table(void)
+bool GxGDEW080T5::setTemperature(int8_t temperature)
+{
+  while (isBusy()); // complete the regions in flight
+  _temperature = temperature;
+  int16_t set = _waveforms ? _waveforms->find(temperature) : -1;
+  if (set != _waveform_set)
+  {
+    free(_waveform_tables);
+    _waveform_tables = 0;
+    _waveform_set = set;
+    if (set >= 0)
+    {
+      _frame_begin_size = _waveforms->beginFrames(set);
+      _frame_end_size = _waveforms->endFrames(set);
+      _transition_size = _frame_begin_size - 1 + _frame_end_size - 3;
+      if (!init_wave_table()) _waveform_set = -1; // out of memory
+    }
+    if (_waveform_set < 0) use_builtin_waveform();
+  }
+  return (_waveform_set >= 0);
+}
+
+void GxGDEW080T5::setMirror(bool mirror_x, bool mirror_y)
+{
+  while (isBusy()); // complete the regions in flight
+  IO.setShiftDirection(mirror_x, mirror_y);
+  _erase_buffer_valid = false; // screen content mirrored
+}
+
+void GxGDEW080T5::use_builtin_waveform(void)
+{
+  _frame_begin_size = GxGDEW080T5_FRAME_BEGIN_SIZE;
+  _frame_end_size = GxGDEW080T5_FRAME_END_SIZE;
+  _transition_size = GxGDEW080T5_FRAME_BEGIN_SIZE - 1 + GxGDEW080T5_FRAME_END_SIZE - 3;
+  wave_begin_table = wave_begin_table_80.table;
+  wave_end_table = wave_end_table_80.table;
+  transition_table = transition_table_80.table;
+  transition_frame_mask = transition_table_80.frame_mask;
+}
+
+uint8_t GxGDEW080T5::wave_drive(bool end, uint8_t level, uint16_t frame)
+{
+  if (_waveform_set >= 0) return _waveforms->drive(_waveform_set, end, level, frame);
+  return end ? wave_end_80[level][frame] : wave_begin_80[level][frame];
+}
+
+bool GxGDEW080T5::init_wave_table(void)
 {
   int frame, num;
   unsigned char tmp, value;
-
-  for (frame = 0; frame < GxGDEW080T5_FRAME_BEGIN_SIZE; frame++)
+  uint32_t wave_size = uint32_t(_frame_begin_size + _frame_end_size) * WAVE_TABLE_SIZE;
+  uint32_t transition_size = uint32_t(_transition_size) * 256;
+  _waveform_tables = (uint8_t*) malloc(wave_size + transition_size + _transition_size * sizeof(uint16_t));
+  if (!_waveform_tables) return false;
+  uint8_t (*begin_table)[WAVE_TABLE_SIZE] = (uint8_t (*)[WAVE_TABLE_SIZE]) _waveform_tables;
+  uint8_t (*end_table)[WAVE_TABLE_SIZE] = begin_table + _frame_begin_size;
+  uint8_t (*table)[256] = (uint8_t (*)[256]) (_waveform_tables + wave_size);
+  uint16_t* frame_mask = (uint16_t*) (_waveform_tables + wave_size + transition_size);
+
+  for (frame = 0; frame < _frame_begin_size; frame++)
   {
     for (num = 0; num < WAVE_TABLE_SIZE; num++)
     {
       tmp = 0;
-      tmp = wave_begin_80[(num) & 0x3][frame];
+      tmp = wave_drive(false, (num) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_begin_80[(num >> 2) & 0x3][frame];
+      tmp |= wave_drive(false, (num >> 2) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_begin_80[(num >> 4) & 0x3][frame];
+      tmp |= wave_drive(false, (num >> 4) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_begin_80[(num >> 6) & 0x3][frame];
+      tmp |= wave_drive(false, (num >> 6) & 0x3, frame);
 
       value = 0;
       value = (tmp << 6) & 0xc0;
       value += (tmp << 2) & 0x30;
       value += (tmp >> 2) & 0x0c;
       value += (tmp >> 6) & 0x03;
-      wave_begin_table[num][frame] = value;
+      begin_table[frame][num] = value;
     }
   }
 
-  //wave_end_table
-  for (frame = 0; frame < GxGDEW080T5_FRAME_END_SIZE; frame++)
+  for (frame = 0; frame < _frame_end_size; frame++)
   {
     for (num = 0; num < WAVE_TABLE_SIZE; num++)
     {
       tmp = 0;
-      tmp = wave_end_80[(num) & 0x3][frame];
+      tmp = wave_drive(true, (num) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_end_80[(num >> 2) & 0x3][frame];
+      tmp |= wave_drive(true, (num >> 2) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_end_80[(num >> 4) & 0x3][frame];
+      tmp |= wave_drive(true, (num >> 4) & 0x3, frame);
 
       tmp = tmp << 2;
       tmp &= 0xfffc;
-      tmp |= wave_end_80[(num >> 6) & 0x3][frame];
+      tmp |= wave_drive(true, (num >> 6) & 0x3, frame);
 
       value = 0;
       value = (tmp << 6) & 0xc0;
       value += (tmp << 2) & 0x30;
       value += (tmp >> 2) & 0x0c;
       value += (tmp >> 6) & 0x03;
-      wave_end_table[num][frame] = value;
+      end_table[frame][num] = value;
+    }
+  }
+  init_transition_table(table, frame_mask);
+  wave_begin_table = begin_table;
+  wave_end_table = end_table;
+  transition_table = table;
+  transition_frame_mask = frame_mask;
+  return true;
+}
+
+uint8_t GxGDEW080T5::transition_drive(uint8_t old_level, uint8_t new_level, uint16_t frame)
+{
+  if (old_level == new_level) return 0; // unchanged pixel
+  if (frame < _frame_begin_size - 1) return wave_drive(false, old_level, frame); // to white
+  return wave_drive(true, new_level, frame - (_frame_begin_size - 1) + 1); // from white
+}
+
+void GxGDEW080T5::init_transition_table(uint8_t (*table)[256], uint16_t* frame_mask)
+{
+  for (uint16_t frame = 0; frame < _transition_size; frame++)
+  {
+    frame_mask[frame] = 0;
+    for (uint8_t o = 0; o < 4; o++)
+    {
+      for (uint8_t n = 0; n < 4; n++)
+      {
+        if (transition_drive(o, n, frame)) frame_mask[frame] |= 1 << (o * 4 + n);
+      }
+    }
+    for (uint16_t num = 0; num < 256; num++)
+    {
+      uint8_t d0 = transition_drive((num >> 6) & 0x3, (num >> 2) & 0x3, frame);
+      uint8_t d1 = transition_drive((num >> 4) & 0x3, num & 0x3, frame);
+      table[frame][num] = (d0 << 2) | d1;
     }
   }
 }
 
 void GxGDEW080T5::DisplayTestPicture(uint8_t nr)
 {
+  while (isBusy()); // complete the regions in flight
+  _erase_buffer_valid = false; // screen content replaced
   unsigned char *ptr;
 
   IO.powerOn();
   delay(25);
 
   ptr = nr == 0 ? (unsigned char *)(BitmapExample1) : (unsigned char *)(BitmapExample2);
-  for (uint16_t frame = 0; frame < GxGDEW080T5_FRAME_BEGIN_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_begin_size; frame++)
   {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDEW080T5_HEIGHT; line++)
     {
-      uint32_t x = line * GxGDEW080T5_ROW_BUFFER_SIZE;
-      for (uint16_t i = 0; i < GxGDEW080T5_ROW_BUFFER_SIZE; i++, x++)
-      {
-        row_buffer[i] = wave_begin_table[ptr[x]][frame];
-      }
-      IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+      build_row(wave_begin_table[frame], ptr, uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_BUFFER_SIZE, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+    output_row(idle);
   }
 
   delay(25);
 
   ptr = nr != 0 ? (unsigned char *)(BitmapExample1) : (unsigned char *)(BitmapExample2);
-  for (uint16_t frame = 0; frame < GxGDEW080T5_FRAME_END_SIZE; frame++)
+  for (uint16_t frame = 0; frame < _frame_end_size; frame++)
   {
+    uint32_t prev = NO_ROW;
+    bool idle = false; // the row sent before is of no drive
     IO.start_scan();
     for (uint16_t line = 0; line < GxGDEW080T5_HEIGHT; line++)
     {
-      uint32_t x = line * GxGDEW080T5_ROW_BUFFER_SIZE;
-      for (uint16_t i = 0; i < GxGDEW080T5_ROW_BUFFER_SIZE; i++, x++)
-      {
-        row_buffer[i] = wave_end_table[ptr[x]][frame];
-      }
-      IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+      build_row(wave_end_table[frame], ptr, uint32_t(line) * GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_BUFFER_SIZE, prev);
+      output_row(idle);
     }
-    IO.send_row(row_buffer, GxGDEW080T5_ROW_BUFFER_SIZE, GxGDEW080T5_CL_DELAY);
+    output_row(idle);
   }
   delay(25);
   IO.powerOff();
@@ -16,6 +16,18 @@ uint16_t GxIO::transfer16Transaction(uint16_t d)
   return readData16Transaction();
 }
 
+void GxIO::writeDataTransaction(const uint8_t* d, uint32_t num)
+{
+  startTransaction();
+  while (num > 0)
+  {
+    writeData(*d);
+    d++;
+    num--;
+  }
+  endTransaction();
+}
+
 uint8_t GxIO::readDataTransaction()
 {
   return 0;
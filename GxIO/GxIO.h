@@ -25,6 +25,7 @@ class GxIO
     virtual uint32_t readRawData32(uint8_t part); // debug purpose
     virtual void writeCommandTransaction(uint8_t c);
     virtual void writeDataTransaction(uint8_t d);
+    virtual void writeDataTransaction(const uint8_t* d, uint32_t num); // block of data, single transaction
     virtual void writeData16Transaction(uint16_t d, uint32_t num = 1);
     virtual void writeCommand(uint8_t c);
     virtual void writeData(uint8_t d);
@@ -35,6 +36,7 @@ class GxIO
     virtual void endTransaction();
     virtual void selectRegister(bool rs_low) {}; // for generalized readData & writeData (RA8875)
     virtual void setBackLight(bool lit);
+    virtual int readBusy(uint8_t pin) {return digitalRead(pin);}; // busy line of display controllers, GxIO_Sim emulates it
 };
 
 #endif
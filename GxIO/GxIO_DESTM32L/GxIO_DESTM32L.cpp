@@ -89,9 +89,19 @@
 #define EPD_CLK_H           EPD_CLK_PORT->BSRR = EPD_CLK_BIT
 #define EPD_CLK_L           EPD_CLK_PORT->BSRR = EPD_CLK_BIT<<16
 
-GxIO_DESTM32L::GxIO_DESTM32L()
+GxIO_DESTM32L::GxIO_DESTM32L() : _bit_bang(*this)
 {
   _pwr_led = PB12;
+  _row_output = &_bit_bang;
+  _next_row_buffer = 0;
+  _source_reverse = false;
+  _gate_reverse = false;
+}
+
+void GxIO_DESTM32L::setRowOutput(GxIO_DESTM32L_RowOutput* row_output)
+{
+  _row_output->wait();
+  _row_output = row_output ? row_output : &_bit_bang;
 }
 
 void GxIO_DESTM32L::init(uint8_t power_on_led)
@@ -128,10 +138,9 @@ void GxIO_DESTM32L::init(uint8_t power_on_led)
   pinMode(VPOS15_CTR_PIN, OUTPUT);
   powerOff();
   //EPD_Init(void)
-  digitalWrite(EPD_SHR_PIN, LOW);     //Shift direction source driver
   digitalWrite(EPD_GMODE1_PIN, HIGH); //one pulse mode
   digitalWrite(EPD_GMODE2_PIN, HIGH); //one pulse mode
-  digitalWrite(EPD_XRL_PIN, HIGH);    //Shift direction gate driver
+  setShiftDirection(_source_reverse, _gate_reverse);
   powerOff();
   EPD_LE_L;
   EPD_CL_L;
@@ -141,6 +150,15 @@ void GxIO_DESTM32L::init(uint8_t power_on_led)
   EPD_CLK_L;
 }
 
+void GxIO_DESTM32L::setShiftDirection(bool source_reverse, bool gate_reverse)
+{
+  _row_output->wait();
+  _source_reverse = source_reverse;
+  _gate_reverse = gate_reverse;
+  digitalWrite(EPD_SHR_PIN, source_reverse ? HIGH : LOW); // shift direction source driver
+  digitalWrite(EPD_XRL_PIN, gate_reverse ? LOW : HIGH); // shift direction gate driver
+}
+
 void GxIO_DESTM32L::powerOn(void)
 {
   digitalWrite(_pwr_led, LOW);
@@ -156,6 +174,7 @@ void GxIO_DESTM32L::powerOn(void)
 
 void GxIO_DESTM32L::powerOff(void)
 {
+  _row_output->wait();
   digitalWrite(VCOM_CTR_PIN, LOW);
   delay35ns(0x2ff);
   digitalWrite(GVDD22_CTR_PIN, LOW);
@@ -169,6 +188,7 @@ void GxIO_DESTM32L::powerOff(void)
 
 void GxIO_DESTM32L::start_scan(void)
 {
+  _row_output->wait();
   EPD_XSPV_H;
 
   uint16_t repeat = 2;
@@ -204,6 +224,36 @@ void GxIO_DESTM32L::start_scan(void)
 }
 
 void GxIO_DESTM32L::send_row(uint8_t row_data[], uint16_t row_size, uint32_t delay_time)
+{
+  const uint8_t* data = row_data;
+  bool async = _row_output->async() && (row_size <= GxIO_DESTM32L_MAX_ROW_SIZE);
+  if (async)
+  {
+    // the row in flight uses the other buffer
+    memcpy(_row_buffers[_next_row_buffer], row_data, row_size);
+    data = _row_buffers[_next_row_buffer];
+    _next_row_buffer ^= 1;
+  }
+  _row_output->wait();
+  begin_row();
+  _row_output->start(data, row_size, delay_time);
+  if (!async) _row_output->wait();
+}
+
+void GxIO_DESTM32L::skip_row(uint32_t delay_time)
+{
+  _row_output->wait();
+  latch_row();
+  next_line(delay_time);
+}
+
+void GxIO_DESTM32L::begin_row(void)
+{
+  latch_row();
+  EPD_SPH_L;
+}
+
+void GxIO_DESTM32L::latch_row(void)
 {
   EPD_LE_H;
   EPD_CL_L;
@@ -222,24 +272,20 @@ void GxIO_DESTM32L::send_row(uint8_t row_data[], uint16_t row_size, uint32_t del
   EPD_CL_H;
   EPD_CL_L;
   EPD_CL_H;
-  EPD_SPH_L;
-
-  for (uint32_t column = 0; column < row_size; column++)
-  {
-    EPD_DB_PORT->BSRR = 0xFF << 16; // reset data bits
-    EPD_DB_PORT->BSRR = (uint16_t)row_data[column]; // set data bits
-    EPD_CL_L;
-    delay35ns(delay_time);
-    EPD_CL_H;
-    delay35ns(delay_time);
-  }
+}
 
+void GxIO_DESTM32L::end_row(uint32_t delay_time)
+{
   EPD_SPH_H;
   EPD_CL_L;
   EPD_CL_H;
   EPD_CL_L;
   EPD_CL_H;
+  next_line(delay_time);
+}
 
+void GxIO_DESTM32L::next_line(uint32_t delay_time)
+{
   EPD_CLK_L;
   EPD_OE_L;
   EPD_CL_L;
@@ -252,6 +298,25 @@ void GxIO_DESTM32L::send_row(uint8_t row_data[], uint16_t row_size, uint32_t del
   delay35ns(delay_time);
 }
 
+void GxIO_DESTM32L::clock_data(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time)
+{
+  for (uint32_t column = 0; column < row_size; column++)
+  {
+    EPD_DB_PORT->BSRR = 0xFF << 16; // reset data bits
+    EPD_DB_PORT->BSRR = (uint16_t)row_data[column]; // set data bits
+    EPD_CL_L;
+    delay35ns(delay_time);
+    EPD_CL_H;
+    delay35ns(delay_time);
+  }
+}
+
+void GxIO_DESTM32L_BitBang::start(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time)
+{
+  IO.clock_data(row_data, row_size, delay_time);
+  IO.end_row(delay_time);
+}
+
 static uint32_t t_delay;
 
 void GxIO_DESTM32L::delay35ns(uint32_t nCount)
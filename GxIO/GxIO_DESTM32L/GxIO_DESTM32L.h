@@ -19,6 +19,36 @@
 
 #include <Arduino.h>
 
+// row sizes up to this are double buffered for asynchronous row output
+#define GxIO_DESTM32L_MAX_ROW_SIZE 256
+
+class GxIO_DESTM32L;
+
+// output of the source data of a row, the part of send_row() between SPH low and SPH high.
+// start() clocks out the row data and then calls GxIO_DESTM32L::end_row() to latch and drive the row.
+// an asynchronous backend returns from start() before the data is out, e.g. with DMA paced by a timer,
+// and completes the row from its interrupt; wait() returns when end_row() of the last row is done.
+// send_row() of an asynchronous backend passes a copy of the row, the caller can build the next row meanwhile.
+class GxIO_DESTM32L_RowOutput
+{
+  public:
+    virtual void start(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time) = 0;
+    virtual void wait(void) {};
+    virtual bool async(void) {return false;};
+};
+
+// reference backend, bit-bang with BSRR writes and delay35ns() for the CL clock, synchronous.
+// note: an asynchronous DMA/timer backend is not provided, on the DESTM32-L CL is on PE5,
+// its timer TIM9 can't trigger DMA2, the only DMA controller with access to the GPIO ports.
+class GxIO_DESTM32L_BitBang : public GxIO_DESTM32L_RowOutput
+{
+  public:
+    GxIO_DESTM32L_BitBang(GxIO_DESTM32L& io) : IO(io) {};
+    void start(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time);
+  private:
+    GxIO_DESTM32L& IO;
+};
+
 class GxIO_DESTM32L
 {
   public:
@@ -29,8 +59,29 @@ class GxIO_DESTM32L
     void powerOff(void);
     void start_scan(void);
     void send_row(uint8_t row_data[], uint16_t row_size, uint32_t delay_time);
+    // advance the gate driver by one row without clocking source data; the source driver keeps the row
+    // clocked in last and drives it on the next row, use only after a row of no drive (all 0x00) was sent
+    void skip_row(uint32_t delay_time);
+    // row output backend, default is GxIO_DESTM32L_BitBang; 0 selects the default
+    void setRowOutput(GxIO_DESTM32L_RowOutput* row_output);
+    // shift direction of the source driver (along a row) and of the gate driver (rows), false is native;
+    // reversed mirrors the image on the panel with the same row data, kept over init(); set between scans
+    void setShiftDirection(bool source_reverse, bool gate_reverse);
+    // for the row output backends: latch and drive the row after its data is clocked out
+    void end_row(uint32_t delay_time);
+  private:
+    friend class GxIO_DESTM32L_BitBang;
+    void begin_row(void);
+    void latch_row(void);
+    void next_line(uint32_t delay_time);
+    void clock_data(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time);
   private:
     uint8_t _pwr_led;
+    GxIO_DESTM32L_BitBang _bit_bang;
+    GxIO_DESTM32L_RowOutput* _row_output;
+    uint8_t _row_buffers[2][GxIO_DESTM32L_MAX_ROW_SIZE]; // for asynchronous row output
+    uint8_t _next_row_buffer;
+    bool _source_reverse, _gate_reverse;
 };
 
 #endif
@@ -0,0 +1,116 @@
+// GxIO_DESTM32L_RowSim : simulated row output backend for GxIO_DESTM32L, for tests of the row output pipeline
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "GxIO_DESTM32L_RowSim.h"
+
+// FNV-1a 32 bit
+static uint32_t hash32(uint32_t hash, const uint8_t* data, uint16_t n)
+{
+  for (uint16_t i = 0; i < n; i++)
+  {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+GxIO_DESTM32L_RowSim::GxIO_DESTM32L_RowSim(GxIO_DESTM32L& io, bool pipelined) :
+  IO(io), _pipelined(pipelined), _busy(false), _cycle_ns(GxIO_DESTM32L_RowSim_defaultCycleTime),
+  _row_data(0), _row_size(0), _row_hash(0), _row_delay(0)
+{
+  clear();
+}
+
+void GxIO_DESTM32L_RowSim::start(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time)
+{
+  _advance();
+  if (_busy) _errors++; // previous row not completed
+  if ((_rows > 0) && (_time_ns > _end_ns)) _idle_ns += _time_ns - _end_ns;
+  uint64_t duration = (uint64_t(row_size) * (2 * delay_time + 2) + GxIO_DESTM32L_RowSim_rowOverhead) * _cycle_ns;
+  _end_ns = _time_ns + duration;
+  _output_ns += duration;
+  if (!_pipelined) _time_ns = _end_ns; // cpu clocks out the data
+  _row_data = row_data;
+  _row_size = row_size;
+  _row_hash = hash32(2166136261UL, row_data, row_size);
+  _row_delay = delay_time;
+  _checksum = hash32(_checksum, row_data, row_size);
+  _rows++;
+  _busy = true;
+}
+
+void GxIO_DESTM32L_RowSim::wait(void)
+{
+  if (!_busy) return;
+  _advance();
+  if (_time_ns < _end_ns)
+  {
+    _stall_ns += _end_ns - _time_ns;
+    _time_ns = _end_ns;
+  }
+  if (hash32(2166136261UL, _row_data, _row_size) != _row_hash) _errors++; // changed while clocked out
+  _busy = false;
+  IO.end_row(_row_delay);
+  _real_us = ::micros(); // latch sequence not counted
+}
+
+void GxIO_DESTM32L_RowSim::setCycleTime(uint32_t ns)
+{
+  _cycle_ns = ns;
+}
+
+void GxIO_DESTM32L_RowSim::clear()
+{
+  _time_ns = 0;
+  _end_ns = 0;
+  _output_ns = 0;
+  _stall_ns = 0;
+  _idle_ns = 0;
+  _rows = 0;
+  _errors = 0;
+  _checksum = 2166136261UL;
+  _real_us = ::micros();
+}
+
+uint32_t GxIO_DESTM32L_RowSim::micros()
+{
+  return uint32_t(_time_ns / 1000);
+}
+
+uint32_t GxIO_DESTM32L_RowSim::rows()
+{
+  return _rows;
+}
+
+uint32_t GxIO_DESTM32L_RowSim::outputTime()
+{
+  return uint32_t(_output_ns / 1000);
+}
+
+uint32_t GxIO_DESTM32L_RowSim::stallTime()
+{
+  return uint32_t(_stall_ns / 1000);
+}
+
+uint32_t GxIO_DESTM32L_RowSim::idleTime()
+{
+  return uint32_t(_idle_ns / 1000);
+}
+
+uint32_t GxIO_DESTM32L_RowSim::errors()
+{
+  return _errors;
+}
+
+uint32_t GxIO_DESTM32L_RowSim::checksum()
+{
+  return _checksum;
+}
+
+void GxIO_DESTM32L_RowSim::_advance(void)
+{
+  uint32_t now = ::micros();
+  _time_ns += uint64_t(now - _real_us) * 1000;
+  _real_us = now;
+}
@@ -0,0 +1,53 @@
+// GxIO_DESTM32L_RowSim : simulated row output backend for GxIO_DESTM32L, for tests of the row output pipeline
+//
+// replaces the clocking of the row data by a model of its duration on a simulated clock,
+// the latch sequence of each row is still done by GxIO_DESTM32L::end_row().
+// the simulated clock advances by the real time spent between calls (building the rows),
+// and by the row output time, in parallel to the cpu if pipelined, else like the bit-bang backend.
+//
+// checks the ordering: a row started before the previous one completed,
+// or row data changed while it is clocked out, is counted as error.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxIO_DESTM32L_RowSim_H_
+#define _GxIO_DESTM32L_RowSim_H_
+
+#include "GxIO_DESTM32L.h"
+
+#define GxIO_DESTM32L_RowSim_defaultCycleTime 35 // ns, per delay35ns() count and per CL edge
+#define GxIO_DESTM32L_RowSim_rowOverhead 32 // CL edges of the row begin and latch sequence
+
+class GxIO_DESTM32L_RowSim : public GxIO_DESTM32L_RowOutput
+{
+  public:
+    // pipelined : asynchronous, a row is clocked out while the next one is built
+    GxIO_DESTM32L_RowSim(GxIO_DESTM32L& io, bool pipelined = true);
+    void start(const uint8_t row_data[], uint16_t row_size, uint32_t delay_time);
+    void wait(void);
+    bool async(void) {return _pipelined;};
+    // simulation control
+    void setCycleTime(uint32_t ns);
+    void clear(); // statistics and clock
+    uint32_t micros(); // simulated clock
+    uint32_t rows();
+    uint32_t outputTime(); // us, clocking out the rows
+    uint32_t stallTime(); // us, cpu waiting for the row output
+    uint32_t idleTime(); // us, row output waiting for the cpu
+    uint32_t errors();
+    uint32_t checksum(); // of all row data, in output order
+  private:
+    void _advance(void);
+  private:
+    GxIO_DESTM32L& IO;
+    bool _pipelined, _busy;
+    uint32_t _cycle_ns;
+    uint64_t _time_ns, _end_ns, _output_ns, _stall_ns, _idle_ns;
+    uint32_t _real_us;
+    uint32_t _rows, _errors, _checksum;
+    const uint8_t* _row_data;
+    uint16_t _row_size;
+    uint32_t _row_hash, _row_delay;
+};
+
+#endif
@@ -84,6 +84,7 @@ void fmsc_sram_init()
 
   /* Delay after an RCC peripheral clock enabling */
   tmp = READ_BIT(RCC->AHB3ENR, RCC_AHB3ENR_FSMCEN);
+  (void)tmp; // only read for the delay after enabling the clocks
   /* Configure and enable Bank1_SRAMx */
   FSMC_Bank1->BTCR[2*(SRAM_SUBBANK-1)] = 0x00001011;
   FSMC_Bank1->BTCR[2*(SRAM_SUBBANK-1) + 1] = (DATAST << 8) | ADDSET; // this is the "BTRx" reg
@@ -116,8 +116,14 @@
 #define EPD_CLK_H           EPD_CLK_PORT->BSRR = EPD_CLK; delay140ns(CLK_DLY);
 #define EPD_CLK_L           EPD_CLK_PORT->BRR = EPD_CLK; delay140ns(CLK_DLY);
 
-GxIO_GreenSTM32F103V::GxIO_GreenSTM32F103V()
+GxIO_GreenSTM32F103V::GxIO_GreenSTM32F103V() : _bit_bang(*this)
 {
+  _row_output = &_bit_bang;
+}
+
+void GxIO_GreenSTM32F103V::setRowOutput(GxIO_GreenSTM32F103V_RowOutput* row_output)
+{
+  _row_output = row_output ? row_output : &_bit_bang;
 }
 
 void GxIO_GreenSTM32F103V::init(void)
@@ -217,7 +223,25 @@ void GxIO_GreenSTM32F103V::start_scan(void)
 
 void GxIO_GreenSTM32F103V::send_row(uint8_t row_data[], uint16_t row_size)
 {
+  begin_row();
+  _row_output->start(row_data, row_size);
+}
+
+void GxIO_GreenSTM32F103V::skip_row(void)
+{
+  latch_row();
+  next_line();
+}
+
+void GxIO_GreenSTM32F103V::begin_row(void)
+{
+  latch_row();
+
+  EPD_SPH_L;
+}
 
+void GxIO_GreenSTM32F103V::latch_row(void)
+{
   EPD_LE_H;
   EPD_CL_L;
   EPD_CL_H;
@@ -235,18 +259,10 @@ void GxIO_GreenSTM32F103V::send_row(uint8_t row_data[], uint16_t row_size)
   EPD_CL_H;
   EPD_CL_L;
   EPD_CL_H;
+}
 
-  EPD_SPH_L;
-
-  for (uint32_t column = 0; column < row_size; column++)
-  {
-    EPD_DB_PORT->BRR = 0xFF; // reset data bits
-    EPD_DB_PORT->BSRR = (uint16_t)row_data[column]; // set data bits
-
-    EPD_CL_L;
-    EPD_CL_H;
-  }
-
+void GxIO_GreenSTM32F103V::end_row(void)
+{
   EPD_SPH_H;
 
   EPD_CL_L;
@@ -254,6 +270,11 @@ void GxIO_GreenSTM32F103V::send_row(uint8_t row_data[], uint16_t row_size)
   EPD_CL_L;
   EPD_CL_H;
 
+  next_line();
+}
+
+void GxIO_GreenSTM32F103V::next_line(void)
+{
   EPD_CLK_L;
   EPD_OE_L;
   EPD_CL_L;
@@ -264,6 +285,24 @@ void GxIO_GreenSTM32F103V::send_row(uint8_t row_data[], uint16_t row_size)
   EPD_CLK_H;
 }
 
+void GxIO_GreenSTM32F103V::clock_data(const uint8_t row_data[], uint16_t row_size)
+{
+  for (uint32_t column = 0; column < row_size; column++)
+  {
+    EPD_DB_PORT->BRR = 0xFF; // reset data bits
+    EPD_DB_PORT->BSRR = (uint16_t)row_data[column]; // set data bits
+
+    EPD_CL_L;
+    EPD_CL_H;
+  }
+}
+
+void GxIO_GreenSTM32F103V_BitBang::start(const uint8_t row_data[], uint16_t row_size)
+{
+  IO.clock_data(row_data, row_size);
+  IO.end_row();
+}
+
 static uint32_t t_delay;
 
 void GxIO_GreenSTM32F103V::delay140ns(uint32_t nCount)
@@ -23,6 +23,27 @@
 
 #include <Arduino.h>
 
+class GxIO_GreenSTM32F103V;
+
+// output of the source data of a row, the part of send_row() between SPH low and SPH high.
+// start() clocks out the row data and then calls GxIO_GreenSTM32F103V::end_row() to latch and drive the row;
+// synchronous, send_row() returns after start().
+class GxIO_GreenSTM32F103V_RowOutput
+{
+  public:
+    virtual void start(const uint8_t row_data[], uint16_t row_size) = 0;
+};
+
+// reference backend, bit-bang with BRR/BSRR writes and delay140ns() for the CL clock.
+class GxIO_GreenSTM32F103V_BitBang : public GxIO_GreenSTM32F103V_RowOutput
+{
+  public:
+    GxIO_GreenSTM32F103V_BitBang(GxIO_GreenSTM32F103V& io) : IO(io) {};
+    void start(const uint8_t row_data[], uint16_t row_size);
+  private:
+    GxIO_GreenSTM32F103V& IO;
+};
+
 class GxIO_GreenSTM32F103V
 {
   public:
@@ -33,6 +54,22 @@ class GxIO_GreenSTM32F103V
     void powerOff(void);
     void start_scan(void);
     void send_row(uint8_t row_data[], uint16_t row_size);
+    // advance the gate driver by one row without clocking source data; the source driver keeps the row
+    // clocked in last and drives it on the next row, use only after a row of no drive (all 0x00) was sent
+    void skip_row(void);
+    // row output backend, default is GxIO_GreenSTM32F103V_BitBang; 0 selects the default
+    void setRowOutput(GxIO_GreenSTM32F103V_RowOutput* row_output);
+    // for the row output backends: latch and drive the row after its data is clocked out
+    void end_row(void);
+  private:
+    friend class GxIO_GreenSTM32F103V_BitBang;
+    void begin_row(void);
+    void latch_row(void);
+    void next_line(void);
+    void clock_data(const uint8_t row_data[], uint16_t row_size);
+  private:
+    GxIO_GreenSTM32F103V_BitBang _bit_bang;
+    GxIO_GreenSTM32F103V_RowOutput* _row_output;
 };
 
 #endif
@@ -0,0 +1,84 @@
+// GxIO_GreenSTM32F103V_RowSim : simulated row output backend for GxIO_GreenSTM32F103V, for benchmarks without display
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "GxIO_GreenSTM32F103V_RowSim.h"
+
+// FNV-1a 32 bit
+static uint32_t hash32(uint32_t hash, const uint8_t* data, uint16_t n)
+{
+  for (uint16_t i = 0; i < n; i++)
+  {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+GxIO_GreenSTM32F103V_RowSim::GxIO_GreenSTM32F103V_RowSim(GxIO_GreenSTM32F103V& io) :
+  IO(io), _cycle_ns(GxIO_GreenSTM32F103V_RowSim_defaultCycleTime)
+{
+  clear();
+}
+
+void GxIO_GreenSTM32F103V_RowSim::start(const uint8_t row_data[], uint16_t row_size)
+{
+  _advance();
+  if (_rows > 0) _idle_ns += _time_ns - _end_ns;
+  uint64_t duration = (uint64_t(row_size) * GxIO_GreenSTM32F103V_RowSim_columnCycles + GxIO_GreenSTM32F103V_RowSim_rowOverhead) * _cycle_ns;
+  _time_ns += duration; // cpu clocks out the data
+  _end_ns = _time_ns;
+  _output_ns += duration;
+  _checksum = hash32(_checksum, row_data, row_size);
+  _rows++;
+  IO.end_row();
+  _real_us = ::micros(); // latch sequence not counted
+}
+
+void GxIO_GreenSTM32F103V_RowSim::setCycleTime(uint32_t ns)
+{
+  _cycle_ns = ns;
+}
+
+void GxIO_GreenSTM32F103V_RowSim::clear()
+{
+  _time_ns = 0;
+  _end_ns = 0;
+  _output_ns = 0;
+  _idle_ns = 0;
+  _rows = 0;
+  _checksum = 2166136261UL;
+  _real_us = ::micros();
+}
+
+uint32_t GxIO_GreenSTM32F103V_RowSim::micros()
+{
+  return uint32_t(_time_ns / 1000);
+}
+
+uint32_t GxIO_GreenSTM32F103V_RowSim::rows()
+{
+  return _rows;
+}
+
+uint32_t GxIO_GreenSTM32F103V_RowSim::outputTime()
+{
+  return uint32_t(_output_ns / 1000);
+}
+
+uint32_t GxIO_GreenSTM32F103V_RowSim::idleTime()
+{
+  return uint32_t(_idle_ns / 1000);
+}
+
+uint32_t GxIO_GreenSTM32F103V_RowSim::checksum()
+{
+  return _checksum;
+}
+
+void GxIO_GreenSTM32F103V_RowSim::_advance(void)
+{
+  uint32_t now = ::micros();
+  _time_ns += uint64_t(now - _real_us) * 1000;
+  _real_us = now;
+}
@@ -0,0 +1,42 @@
+// GxIO_GreenSTM32F103V_RowSim : simulated row output backend for GxIO_GreenSTM32F103V, for benchmarks without display
+//
+// replaces the clocking of the row data by a model of its duration on a simulated clock,
+// the latch sequence of each row is still done by GxIO_GreenSTM32F103V::end_row().
+// the simulated clock advances by the real time spent between calls (building the rows),
+// and by the row output time; synchronous, the cpu clocks out the data as with the bit-bang backend.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxIO_GreenSTM32F103V_RowSim_H_
+#define _GxIO_GreenSTM32F103V_RowSim_H_
+
+#include "GxIO_GreenSTM32F103V.h"
+
+#define GxIO_GreenSTM32F103V_RowSim_defaultCycleTime 140 // ns, per delay140ns() count
+#define GxIO_GreenSTM32F103V_RowSim_columnCycles 8 // delay140ns() counts per byte, 2 CL edges
+#define GxIO_GreenSTM32F103V_RowSim_rowOverhead 82 // delay140ns() counts of the row begin and latch sequence
+
+class GxIO_GreenSTM32F103V_RowSim : public GxIO_GreenSTM32F103V_RowOutput
+{
+  public:
+    GxIO_GreenSTM32F103V_RowSim(GxIO_GreenSTM32F103V& io);
+    void start(const uint8_t row_data[], uint16_t row_size);
+    // simulation control
+    void setCycleTime(uint32_t ns);
+    void clear(); // statistics and clock
+    uint32_t micros(); // simulated clock
+    uint32_t rows();
+    uint32_t outputTime(); // us, clocking out the rows
+    uint32_t idleTime(); // us, row output waiting for the cpu
+    uint32_t checksum(); // of all row data, in output order
+  private:
+    void _advance(void);
+  private:
+    GxIO_GreenSTM32F103V& IO;
+    uint32_t _cycle_ns;
+    uint64_t _time_ns, _end_ns, _output_ns, _idle_ns;
+    uint32_t _real_us;
+    uint32_t _rows, _checksum;
+};
+
+#endif
@@ -5,6 +5,32 @@
 
 #include "GxIO_SPI.h"
 
+// write a block of data without chip select handling, used inside transactions
+static void writeBlock(SPIClass& spi, const uint8_t* d, uint32_t num)
+{
+#if defined(ESP8266) || defined(ESP32)
+  spi.writeBytes((uint8_t*)d, num);
+#elif defined(SPI_HAS_TRANSACTION)
+  // transfer(buffer, size) is in place, use a local copy
+  uint8_t buffer[GxIO_SPI_BLOCK_SIZE];
+  while (num > 0)
+  {
+    uint16_t n = (num > sizeof(buffer)) ? sizeof(buffer) : num;
+    memcpy(buffer, d, n);
+    spi.transfer(buffer, n);
+    d += n;
+    num -= n;
+  }
+#else
+  while (num > 0)
+  {
+    spi.transfer(*d);
+    d++;
+    num--;
+  }
+#endif
+}
+
 GxIO_SPI::GxIO_SPI(SPIClass& spi, int8_t cs, int8_t dc, int8_t rst, int8_t bl) : IOSPI(spi)
 {
   _cs   = cs;
@@ -180,6 +206,13 @@ void GxIO_SPI::writeDataTransaction(uint8_t d)
   if (_cs >= 0) digitalWrite(_cs, HIGH);
 }
 
+void GxIO_SPI::writeDataTransaction(const uint8_t* d, uint32_t num)
+{
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  writeBlock(IOSPI, d, num);
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+}
+
 void GxIO_SPI::writeData16Transaction(uint16_t d, uint32_t num)
 {
   if (_cs >= 0) digitalWrite(_cs, LOW);
@@ -390,6 +423,21 @@ void GxIO_SPI_USING_TRANSACTION::writeDataTransaction(uint8_t d)
   if (_cs >= 0) digitalWrite(_cs, HIGH);
 }
 
+void GxIO_SPI_USING_TRANSACTION::writeDataTransaction(const uint8_t* d, uint32_t num)
+{
+  IOSPI.beginTransaction(_ss, settings);
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  while (num > 1)
+  {
+    IOSPI.transfer(_ss, *d, SPI_CONTINUE);
+    d++;
+    num--;
+  }
+  if (num > 0) IOSPI.transfer(_ss, *d);
+  IOSPI.endTransaction();
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+}
+
 void GxIO_SPI_USING_TRANSACTION::writeData16Transaction(uint16_t d, uint32_t num)
 {
   IOSPI.beginTransaction(_ss, settings);
@@ -594,6 +642,15 @@ void GxIO_SPI_USING_TRANSACTION::writeDataTransaction(uint8_t d)
   IOSPI.endTransaction();
 }
 
+void GxIO_SPI_USING_TRANSACTION::writeDataTransaction(const uint8_t* d, uint32_t num)
+{
+  IOSPI.beginTransaction(settings);
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  writeBlock(IOSPI, d, num);
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  IOSPI.endTransaction();
+}
+
 void GxIO_SPI_USING_TRANSACTION::writeData16Transaction(uint16_t d, uint32_t num)
 {
   IOSPI.beginTransaction(settings);
@@ -10,6 +10,13 @@
 
 #define GxIO_SPI_defaultFrequency 16000000
 
+// local buffer size for block writes using the in place SPI.transfer(buffer, size)
+#if defined(__AVR)
+#define GxIO_SPI_BLOCK_SIZE 16
+#else
+#define GxIO_SPI_BLOCK_SIZE 64
+#endif
+
 class GxIO_SPI : public GxIO
 {
   public:
@@ -27,6 +34,7 @@ class GxIO_SPI : public GxIO
     uint16_t readData16();
     void writeCommandTransaction(uint8_t c);
     void writeDataTransaction(uint8_t d);
+    void writeDataTransaction(const uint8_t* d, uint32_t num);
     void writeData16Transaction(uint16_t d, uint32_t num = 1);
     void writeCommand(uint8_t c);
     void writeData(uint8_t d);
@@ -68,6 +76,7 @@ class GxIO_SPI_USING_TRANSACTION : public GxIO
     uint16_t readData16();
     void writeCommandTransaction(uint8_t c);
     void writeDataTransaction(uint8_t d);
+    void writeDataTransaction(const uint8_t* d, uint32_t num);
     void writeData16Transaction(uint16_t d, uint32_t num = 1);
     void writeCommand(uint8_t c);
     void writeData(uint8_t d);
@@ -0,0 +1,457 @@
+// GxIO_Sim : simulated io class, for host side tests and benchmarks of the display classes without hardware
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "GxIO_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// step address counter from start to end, inclusive; true on wrap around
+static bool step(uint16_t& counter, uint16_t start, uint16_t end, bool increment)
+{
+  if (counter == end)
+  {
+    counter = start;
+    return true;
+  }
+  if (increment) counter++;
+  else counter--;
+  return false;
+}
+
+GxIO_Sim::GxIO_Sim(Controller controller, uint16_t width, uint16_t height, uint8_t bpp) :
+  _controller(controller), _width(width), _height(height), _bpp(bpp),
+  _records(0), _record_count(0), _record_capacity(0),
+  _recording(true), _mirror_x(false), _mirror_y(false),
+  _command(0), _param_index(0), _plane(0), _entry_mode(0x03), _update_option(0),
+  _x_start(0), _x_end(0), _y_start(0), _y_end(0), _x(0), _y(0), _ram_index(0), _partial(false)
+{
+  _ram_size = (uint32_t(width) * bpp + 7) / 8 * height;
+  _ram[0] = (uint8_t*) malloc(_ram_size);
+  _ram[1] = (uint8_t*) malloc(_ram_size);
+  if (_ram[0]) memset(_ram[0], 0xFF, _ram_size);
+  if (_ram[1]) memset(_ram[1], 0xFF, _ram_size);
+  memset(_busy_time, 0, sizeof(_busy_time));
+  if (_controller == SSD1607)
+  {
+    _busy_time[0xc0] = 80000; // clock and analog on
+    _busy_time[0xc3] = 80000; // power off
+    _busy_time[0xc4] = 1200000; // full update
+    _busy_time[0xc7] = 1200000; // full update, with power on and off
+    _busy_time[0x04] = 300000; // partial update
+    // the SSD1607 panels of this library scan the RAM in reverse
+    _mirror_x = true;
+    _mirror_y = true;
+    _x_end = (width + 7) / 8 - 1;
+    _y_end = height - 1;
+  }
+  else
+  {
+    _busy_time[0x02] = 20000; // power off
+    _busy_time[0x04] = 80000; // power on
+    _busy_time[0x12] = 4000000; // display refresh
+    _busy_time[0x91] = 600000; // display refresh in partial mode
+  }
+  setFrequency(GxIO_Sim_defaultFrequency);
+  setTransactionTime(GxIO_Sim_defaultTransactionTime);
+  _time_ns = 0;
+  _busy_until_ns = 0;
+  clear();
+}
+
+GxIO_Sim::~GxIO_Sim()
+{
+  free(_ram[0]);
+  free(_ram[1]);
+  free(_records);
+}
+
+void GxIO_Sim::reset()
+{
+  _write(GxIO_Sim_RESET);
+  _advance(240000000UL); // delays of GxIO_SPI::reset()
+  _busy_until_ns = 0;
+  _command = 0;
+  _param_index = 0;
+  _partial = false;
+}
+
+void GxIO_Sim::init()
+{
+  reset();
+}
+
+void GxIO_Sim::setFrequency(uint32_t freq)
+{
+  _byte_ns = (freq > 0) ? 8000000000ULL / freq : 0;
+}
+
+void GxIO_Sim::writeCommandTransaction(uint8_t c)
+{
+  _calls++;
+  _startTransaction();
+  _writeCommand(c);
+}
+
+void GxIO_Sim::writeDataTransaction(uint8_t d)
+{
+  _calls++;
+  _startTransaction();
+  _writeData(d);
+}
+
+void GxIO_Sim::writeDataTransaction(const uint8_t* d, uint32_t num)
+{
+  _calls++;
+  _startTransaction();
+  while (num > 0)
+  {
+    _writeData(*d);
+    d++;
+    num--;
+  }
+}
+
+void GxIO_Sim::writeData16Transaction(uint16_t d, uint32_t num)
+{
+  _calls++;
+  _startTransaction();
+  while (num > 0)
+  {
+    _writeData(d >> 8);
+    _writeData(d);
+    num--;
+  }
+}
+
+void GxIO_Sim::writeCommand(uint8_t c)
+{
+  _calls++;
+  _writeCommand(c);
+}
+
+void GxIO_Sim::writeData(uint8_t d)
+{
+  _calls++;
+  _writeData(d);
+}
+
+void GxIO_Sim::writeData(uint8_t* d, uint32_t num)
+{
+  _calls++;
+  while (num > 0)
+  {
+    _writeData(*d);
+    d++;
+    num--;
+  }
+}
+
+void GxIO_Sim::writeData16(uint16_t d, uint32_t num)
+{
+  _calls++;
+  while (num > 0)
+  {
+    _writeData(d >> 8);
+    _writeData(d);
+    num--;
+  }
+}
+
+void GxIO_Sim::writeAddrMSBfirst(uint16_t d)
+{
+  _calls++;
+  _writeData(d >> 8);
+  _writeData(d);
+}
+
+void GxIO_Sim::startTransaction()
+{
+  _calls++;
+  _startTransaction();
+}
+
+void GxIO_Sim::endTransaction()
+{
+}
+
+void GxIO_Sim::_writeCommand(uint8_t c)
+{
+  _advance(_byte_ns);
+  _write(GxIO_Sim_COMMAND | c);
+  _commands++;
+  _command = c;
+  _param_index = 0;
+  if (_controller == SSD1607)
+  {
+    if ((c == 0x24) || (c == 0x26)) _plane = (c == 0x24) ? 0 : 1;
+    if (c == 0x20) // master activation
+    {
+      _busy_until_ns = _time_ns + uint64_t(_busy_time[_update_option]) * 1000;
+    }
+  }
+  else
+  {
+    if (c == 0x91) _partial = true; // partial in
+    if (c == 0x92) _partial = false; // partial out
+    if ((c == 0x10) || (c == 0x13))
+    {
+      _plane = (c == 0x10) ? 0 : 1;
+      _ram_index = 0;
+      _x = _x_start * _bpp / 8;
+      _y = _y_start;
+    }
+    uint8_t trigger = ((c == 0x12) && _partial) ? 0x91 : c;
+    if ((c != 0x91) && (_busy_time[trigger] > 0))
+    {
+      _busy_until_ns = _time_ns + uint64_t(_busy_time[trigger]) * 1000;
+    }
+  }
+}
+
+void GxIO_Sim::_writeData(uint8_t d)
+{
+  _advance(_byte_ns);
+  _write(d);
+  _data_bytes++;
+  if (_controller == SSD1607)
+  {
+    switch (_command)
+    {
+      case 0x11: // data entry mode
+        _entry_mode = d;
+        break;
+      case 0x22: // display update control 2
+        _update_option = d;
+        break;
+      case 0x44: // RAM X address start / end, in bytes
+        if (_param_index == 0) _x_start = d;
+        else if (_param_index == 1) _x_end = d;
+        break;
+      case 0x45: // RAM Y address start / end
+        if (_param_index == 0) _y_start = d;
+        else if (_param_index == 1) _y_start |= uint16_t(d) << 8;
+        else if (_param_index == 2) _y_end = d;
+        else if (_param_index == 3) _y_end |= uint16_t(d) << 8;
+        break;
+      case 0x4E: // RAM X address counter
+        if (_param_index == 0) _x = d;
+        break;
+      case 0x4F: // RAM Y address counter
+        if (_param_index == 0) _y = d;
+        else if (_param_index == 1) _y |= uint16_t(d) << 8;
+        break;
+      case 0x24:
+      case 0x26:
+        _writeRam(d);
+        break;
+    }
+  }
+  else
+  {
+    switch (_command)
+    {
+      case 0x90: // partial window, x in pixels
+        if (_param_index == 0) _x_start = uint16_t(d) << 8;
+        else if (_param_index == 1) _x_start |= d;
+        else if (_param_index == 2) _x_end = uint16_t(d) << 8;
+        else if (_param_index == 3) _x_end |= d;
+        else if (_param_index == 4) _y_start = uint16_t(d) << 8;
+        else if (_param_index == 5) _y_start |= d;
+        else if (_param_index == 6) _y_end = uint16_t(d) << 8;
+        else if (_param_index == 7) _y_end |= d;
+        break;
+      case 0x10:
+      case 0x13:
+        _writeRam(d);
+        break;
+    }
+  }
+  _param_index++;
+}
+
+void GxIO_Sim::_startTransaction()
+{
+  _transactions++;
+  _advance(_transaction_ns);
+}
+
+int GxIO_Sim::readBusy(uint8_t)
+{
+  bool busy = _isBusy();
+  if (busy)
+  {
+    _advance(uint32_t(GxIO_Sim_busyPollTime) * 1000);
+    _busy_wait_us += GxIO_Sim_busyPollTime;
+  }
+  if (_controller == SSD1607) return busy ? HIGH : LOW;
+  return busy ? LOW : HIGH;
+}
+
+void GxIO_Sim::setBusyTime(uint8_t trigger, uint32_t us)
+{
+  _busy_time[trigger] = us;
+}
+
+void GxIO_Sim::setTransactionTime(uint32_t ns)
+{
+  _transaction_ns = ns;
+}
+
+void GxIO_Sim::setRecording(bool enabled)
+{
+  _recording = enabled;
+}
+
+void GxIO_Sim::setMirror(bool mirror_x, bool mirror_y)
+{
+  _mirror_x = mirror_x;
+  _mirror_y = mirror_y;
+}
+
+uint32_t GxIO_Sim::micros()
+{
+  return uint32_t(_time_ns / 1000);
+}
+
+uint32_t GxIO_Sim::busyTime()
+{
+  return _busy_wait_us;
+}
+
+uint32_t GxIO_Sim::calls()
+{
+  return _calls;
+}
+
+uint32_t GxIO_Sim::commands()
+{
+  return _commands;
+}
+
+uint32_t GxIO_Sim::dataBytes()
+{
+  return _data_bytes;
+}
+
+uint32_t GxIO_Sim::transactions()
+{
+  return _transactions;
+}
+
+uint32_t GxIO_Sim::recordCount()
+{
+  return _record_count;
+}
+
+const GxIO_Sim_Record& GxIO_Sim::record(uint32_t index)
+{
+  return _records[index];
+}
+
+void GxIO_Sim::clear()
+{
+  _record_count = 0;
+  _busy_until_ns = _isBusy() ? _busy_until_ns - _time_ns : 0; // keep busy
+  _time_ns = 0;
+  _busy_wait_us = 0;
+  _calls = 0;
+  _commands = 0;
+  _data_bytes = 0;
+  _transactions = 0;
+}
+
+const uint8_t* GxIO_Sim::ram(uint8_t plane)
+{
+  return _ram[plane ? 1 : 0];
+}
+
+uint32_t GxIO_Sim::ramSize()
+{
+  return _ram_size;
+}
+
+bool GxIO_Sim::writePGM(const char* filename, uint8_t plane, bool invert)
+{
+  const uint8_t* ram = _ram[plane ? 1 : 0];
+  if (!ram) return false;
+  FILE* f = fopen(filename, "wb");
+  if (!f) return false;
+  fprintf(f, "P5\n%u %u\n255\n", _width, _height);
+  uint32_t row_size = (uint32_t(_width) * _bpp + 7) / 8;
+  uint8_t mask = (1 << _bpp) - 1;
+  for (uint16_t y = 0; y < _height; y++)
+  {
+    uint16_t ry = _mirror_y ? _height - y - 1 : y;
+    for (uint16_t x = 0; x < _width; x++)
+    {
+      uint16_t rx = _mirror_x ? _width - x - 1 : x;
+      uint32_t bit = uint32_t(rx) * _bpp;
+      uint8_t value = (ram[ry * row_size + bit / 8] >> (8 - _bpp - bit % 8)) & mask;
+      // 1 bpp : bit set is white; multi bpp : 0 black .. 3 white (UC8159 class, higher values are colors)
+      uint8_t grey = (_bpp == 1) ? (value ? 255 : 0) : ((value < 3) ? value * 85 : 255);
+      fputc(invert ? 255 - grey : grey, f);
+    }
+  }
+  return (fclose(f) == 0);
+}
+
+void GxIO_Sim::_write(uint16_t value)
+{
+  if (!_recording) return;
+  if (_record_count >= _record_capacity)
+  {
+    uint32_t capacity = _record_capacity ? 2 * _record_capacity : 1024;
+    GxIO_Sim_Record* records = (GxIO_Sim_Record*) realloc(_records, capacity * sizeof(GxIO_Sim_Record));
+    if (!records) return;
+    _records = records;
+    _record_capacity = capacity;
+  }
+  _records[_record_count].time = micros();
+  _records[_record_count].value = value;
+  _record_count++;
+}
+
+void GxIO_Sim::_writeRam(uint8_t d)
+{
+  uint8_t* ram = _ram[_plane];
+  if (!ram) return;
+  if (_controller == SSD1607)
+  {
+    uint32_t row_size = (uint32_t(_width) * _bpp + 7) / 8;
+    if ((_x < row_size) && (_y < _height)) ram[_y * row_size + _x] = d;
+    bool x_increment = _entry_mode & 0x01;
+    bool y_increment = _entry_mode & 0x02;
+    if (_entry_mode & 0x04) // address counter updated in Y direction first
+    {
+      if (step(_y, _y_start, _y_end, y_increment)) step(_x, _x_start, _x_end, x_increment);
+    }
+    else
+    {
+      if (step(_x, _x_start, _x_end, x_increment)) step(_y, _y_start, _y_end, y_increment);
+    }
+  }
+  else if (_partial) // to the partial window
+  {
+    uint32_t row_size = (uint32_t(_width) * _bpp + 7) / 8;
+    if ((_x < row_size) && (_y < _height)) ram[_y * row_size + _x] = d;
+    if (step(_x, _x_start * _bpp / 8, ((_x_end + 1) * _bpp - 1) / 8, true)) step(_y, _y_start, _y_end, true);
+  }
+  else
+  {
+    ram[_ram_index] = d;
+    _ram_index = (_ram_index + 1) % _ram_size;
+  }
+}
+
+void GxIO_Sim::_advance(uint32_t ns)
+{
+  _time_ns += ns;
+}
+
+bool GxIO_Sim::_isBusy()
+{
+  return (_time_ns < _busy_until_ns);
+}
+
@@ -0,0 +1,115 @@
+// GxIO_Sim : simulated io class, for host side tests and benchmarks of the display classes without hardware
+//
+// records every command and data byte with a timestamp of a simulated clock,
+// emulates the busy line with configurable busy times, and decodes the RAM writes
+// of SSD1607 or UC8151 type controllers into RAM images that can be saved as PGM files.
+//
+// the simulated clock advances by the SPI byte time (see setFrequency()) for each byte,
+// by a chip select overhead for each transaction, and by 1ms for each read of an active busy line
+// (the display classes poll the busy line with delay(1)); other delays are not seen.
+//
+// needs the Arduino API (Arduino.h) and stdio, on a host an Arduino API emulation is needed.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxIO_Sim_H_
+#define _GxIO_Sim_H_
+
+#include "../GxIO.h"
+
+#define GxIO_Sim_defaultFrequency 4000000
+#define GxIO_Sim_defaultTransactionTime 2000 // ns, chip select handling with digitalWrite()
+#define GxIO_Sim_busyPollTime 1000 // us, the delay(1) of the display classes
+
+struct GxIO_Sim_Record
+{
+  uint32_t time; // us, simulated clock
+  uint16_t value; // data byte, or GxIO_Sim_COMMAND | command, or GxIO_Sim_RESET
+};
+
+#define GxIO_Sim_COMMAND 0x100
+#define GxIO_Sim_RESET 0x200
+
+class GxIO_Sim : public GxIO
+{
+  public:
+    enum Controller {SSD1607, UC8151};
+    // width, height : controller RAM size in pixel, bpp : bits per pixel of the RAM (UC8151 class 1 or 4)
+    GxIO_Sim(Controller controller, uint16_t width, uint16_t height, uint8_t bpp = 1);
+    ~GxIO_Sim();
+    const char* name = "GxIO_Sim";
+    void reset();
+    void init();
+    void setFrequency(uint32_t freq); // for SPI byte time
+    void setClockDivider(uint32_t) {};
+    void writeCommandTransaction(uint8_t c);
+    void writeDataTransaction(uint8_t d);
+    void writeDataTransaction(const uint8_t* d, uint32_t num);
+    void writeData16Transaction(uint16_t d, uint32_t num = 1);
+    void writeCommand(uint8_t c);
+    void writeData(uint8_t d);
+    void writeData(uint8_t* d, uint32_t num);
+    void writeData16(uint16_t d, uint32_t num = 1);
+    void writeAddrMSBfirst(uint16_t d);
+    void startTransaction();
+    void endTransaction();
+    void setBackLight(bool) {};
+    int readBusy(uint8_t);
+    // simulation control
+    // busy time after trigger : SSD1607 display update control 2 option (0x22) at master activation (0x20), UC8151 command;
+    // UC8151 display refresh (0x12) in partial mode uses the busy time of partial in (0x91)
+    void setBusyTime(uint8_t trigger, uint32_t us);
+    void setTransactionTime(uint32_t ns); // chip select overhead per transaction
+    void setRecording(bool enabled); // enabled by default
+    void setMirror(bool mirror_x, bool mirror_y); // RAM to image orientation, for writePGM()
+    uint32_t micros(); // simulated clock
+    uint32_t busyTime(); // time spent polling the active busy line, us
+    uint32_t calls(); // of GxIO methods, by the display class
+    uint32_t commands();
+    uint32_t dataBytes();
+    uint32_t transactions(); // chip select toggles
+    uint32_t recordCount();
+    const GxIO_Sim_Record& record(uint32_t index);
+    void clear(); // records, statistics and clock, not the RAM
+    // RAM image, plane 0 : SSD1607 0x24, UC8151 0x10, plane 1 : SSD1607 0x26, UC8151 0x13
+    const uint8_t* ram(uint8_t plane);
+    uint32_t ramSize();
+    // write RAM plane as binary PGM image, bit set is white, unless inverted; false if file can't be written
+    bool writePGM(const char* filename, uint8_t plane = 0, bool invert = false);
+  private:
+    void _writeCommand(uint8_t c);
+    void _writeData(uint8_t d);
+    void _startTransaction();
+    void _write(uint16_t value);
+    void _writeRam(uint8_t d);
+    void _advance(uint32_t ns);
+    bool _isBusy();
+  private:
+    Controller _controller;
+    uint16_t _width, _height;
+    uint8_t _bpp;
+    uint32_t _ram_size;
+    uint8_t* _ram[2];
+    uint32_t _busy_time[256];
+    uint32_t _byte_ns, _transaction_ns;
+    uint64_t _time_ns, _busy_until_ns;
+    uint32_t _busy_wait_us;
+    uint32_t _calls, _commands, _data_bytes, _transactions;
+    GxIO_Sim_Record* _records;
+    uint32_t _record_count, _record_capacity;
+    bool _recording, _mirror_x, _mirror_y;
+    // controller state
+    uint8_t _command;
+    uint16_t _param_index;
+    uint8_t _plane;
+    uint8_t _entry_mode, _update_option;
+    uint16_t _x_start, _x_end, _y_start, _y_end, _x, _y; // SSD1607 window and address counter, x in bytes
+    // UC8151 partial window (0x90) in _x_start .. _y_end, x in pixels, and its address counter _x, _y, x in bytes
+    uint32_t _ram_index; // UC8151 data pointer
+    bool _partial; // UC8151 partial mode, partial in (0x91) .. partial out (0x92)
+};
+
+#define GxIO_Class GxIO_Sim
+
+#endif
+
@@ -0,0 +1,94 @@
+// GxEPD_MirrorTableBenchmark : the row upload conversion of the SSD1607 class display classes, bit loop versus table
+//
+// a buffer byte is uploaded with bit order reversed and inverted (GxEPD_MirrorTable.h);
+// checks the table against the bit loop it replaced for all 256 values,
+// and reports the time to convert the rows of a 200 x 200 pixel frame with each.
+//
+// no display needed, runs on any target, or on a host with the Arduino API emulation of extras/host: make run, in extras/host.
+
+#include <GxEPD_MirrorTable.h>
+
+#define FRAME_ROWS 200
+#define ROW_BYTES (200 / 8)
+#define FRAMES 50
+
+// prototypes, for builds without the Arduino IDE
+uint8_t mirrorInvertLoop(uint8_t data);
+bool checkTable();
+uint32_t frameChecksum(bool table);
+
+uint8_t row[ROW_BYTES];
+uint8_t converted[ROW_BYTES];
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println("GxEPD_MirrorTableBenchmark");
+  Serial.print("table equals bit loop : ");
+  Serial.println(checkTable() ? "ok" : "FAILED");
+  uint32_t start = micros();
+  uint32_t loop_checksum = frameChecksum(false);
+  uint32_t loop_time = micros() - start;
+  start = micros();
+  uint32_t table_checksum = frameChecksum(true);
+  uint32_t table_time = micros() - start;
+  Serial.print("frame of ");
+  Serial.print(FRAME_ROWS);
+  Serial.print(" rows of ");
+  Serial.print(ROW_BYTES);
+  Serial.print(" bytes, us per frame, average of ");
+  Serial.print(FRAMES);
+  Serial.println(" frames");
+  Serial.print("bit loop : ");
+  Serial.println(loop_time / FRAMES);
+  Serial.print("table    : ");
+  Serial.println(table_time / FRAMES);
+  Serial.print("same output : ");
+  Serial.println(loop_checksum == table_checksum ? "ok" : "FAILED");
+  Serial.println("done");
+}
+
+void loop()
+{
+}
+
+// the conversion before GxEPD_MirrorTable.h
+uint8_t mirrorInvertLoop(uint8_t data)
+{
+  uint8_t mirror = 0x00;
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    mirror |= ((data >> i) & 0x01) << (7 - i);
+  }
+  return ~mirror;
+}
+
+bool checkTable()
+{
+  for (uint16_t b = 0; b < 256; b++)
+  {
+    if (GxEPD_mirrorInvert(b) != mirrorInvertLoop(b)) return false;
+  }
+  return true;
+}
+
+// converts the rows of FRAMES frames, the row content changes per row; the checksum keeps the work from being optimized away
+uint32_t frameChecksum(bool table)
+{
+  uint32_t checksum = 0;
+  for (uint8_t x = 0; x < ROW_BYTES; x++) row[x] = x * 37 + 11;
+  for (uint16_t frame = 0; frame < FRAMES; frame++)
+  {
+    for (uint16_t y = 0; y < FRAME_ROWS; y++)
+    {
+      row[y % ROW_BYTES] += y;
+      for (uint8_t x = 0; x < ROW_BYTES; x++)
+      {
+        converted[x] = table ? GxEPD_mirrorInvert(row[x]) : mirrorInvertLoop(row[x]);
+      }
+      checksum = checksum * 31 + converted[y % ROW_BYTES];
+    }
+  }
+  return checksum;
+}
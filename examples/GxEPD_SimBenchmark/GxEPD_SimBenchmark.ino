@@ -0,0 +1,292 @@
+/************************************************************************************
+   GxEPD_SimBenchmark : benchmark of the display classes against simulated io
+
+   Author : J-M Zingg
+
+   Version : 1.0
+
+   Support: minimal, provided as example only, as is, no claim to be fit for serious use
+
+   no display needed, runs on any target with enough RAM for the selected display class (not AVR),
+   or on a host with the Arduino API emulation of extras/host: make run, in extras/host.
+
+   the SPI display classes run against the simulated io class GxIO_Sim, for each operation it reports:
+   cpu    : elapsed micros() of the target, or real time of the host without the emulated delays, includes the cost
+            of the simulation; on a target it includes the waits on the busy line too
+   wait   : time of delay() and delayMicroseconds() in us on a host, the emulated waits on the busy line; 0 on a target
+   calls  : GxIO method calls by the display class
+   cs     : transactions, chip select toggles
+   cmds   : command bytes
+   data   : data bytes
+   wire   : simulated time of the io in us, without busy time
+   busy   : simulated time waiting on the busy line in us
+
+   the parallel interface display classes run against the simulated row output backend of their io class:
+   GxGDE043A2, GxGDE060BA and GxGDEW080T5 with GxIO_DESTM32L_RowSim, pipelined, GxGDE06 with GxIO_GreenSTM32F103V_RowSim;
+   on a host the FSMC SRAM of the DESTM32-L board is in host memory. for each operation it reports:
+   cpu    : elapsed micros() of the target, or real time of the host without the emulated delays, building the rows;
+            on a target it includes the power sequence delays too
+   wait   : time of delay() and delayMicroseconds() in us on a host, the power sequence delays; 0 on a target
+   rows   : rows clocked out, skipped rows are not counted
+   output : simulated time clocking out the rows in us
+   stall  : simulated time the cpu waits for the row output in us (GxIO_DESTM32L_RowSim)
+   idle   : simulated time the row output waits for the cpu between the rows of the operation in us
+   errors : row ordering errors (GxIO_DESTM32L_RowSim)
+*/
+
+// include library, include base class, make path known
+#include <GxEPD.h>
+
+#if defined(GxEPD_HOST)
+// FSMC SRAM of the DESTM32-L board, for the HD parallel display classes
+void* host_sram(size_t size)
+{
+  static void* sram = calloc(1, size);
+  return sram;
+}
+#define FMSC_SRAM ((fmsc_sram_type*)host_sram(sizeof(fmsc_sram_type)))
+#endif
+
+// select the display class to use, only one; host builds select it with GxEPD_SIM_DISPLAY
+#if defined(GxEPD_SIM_DISPLAY)
+#include GxEPD_SIM_DISPLAY
+#else
+#include <GxGDEP015OC1/GxGDEP015OC1.cpp>
+//#include <GxGDE0213B1/GxGDE0213B1.cpp>
+//#include <GxGDEH029A1/GxGDEH029A1.cpp>
+//#include <GxGDEW027C44/GxGDEW027C44.cpp>
+//#include <GxGDEW042T2/GxGDEW042T2.cpp>
+//#include <GxGDEW075T8/GxGDEW075T8.cpp>
+//#include <GxGDE043A2/GxGDE043A2.cpp>
+//#include <GxGDE060BA/GxGDE060BA.cpp>
+//#include <GxGDEW080T5/GxGDEW080T5.cpp>
+//#include <GxGDE06/GxGDE06.cpp>
+#endif
+
+// FreeFonts from Adafruit_GFX
+#include <Fonts/FreeMonoBold9pt7b.h>
+
+// io class and simulation of the selected display class
+#if defined(_GxGDE043A2_H) || defined(_GxGDE060BA_H) || defined(_GxGDEW080T5_H)
+#include <GxIO/GxIO_DESTM32L/GxIO_DESTM32L.cpp>
+#include <GxIO/GxIO_DESTM32L/GxIO_DESTM32L_RowSim.cpp>
+GxIO_DESTM32L io;
+GxIO_DESTM32L_RowSim row_sim(io);
+#define PARALLEL_DISPLAY
+#define HAS_ROW_PIPELINE
+#elif defined(_GxGDE06_H)
+#include <GxIO/GxIO_GreenSTM32F103V/GxIO_GreenSTM32F103V.cpp>
+#include <GxIO/GxIO_GreenSTM32F103V/GxIO_GreenSTM32F103V_RowSim.cpp>
+GxIO_GreenSTM32F103V io;
+GxIO_GreenSTM32F103V_RowSim row_sim(io);
+#define PARALLEL_DISPLAY
+#else
+#include <GxIO/GxIO_Sim/GxIO_Sim.cpp>
+#include <GxIO/GxIO.cpp>
+// controller class and RAM size of the selected display class
+#if defined(_GxGDEW075T8_H_)
+GxIO_Class io(GxIO_Sim::UC8151, GxEPD_WIDTH, GxEPD_HEIGHT, 4);
+#elif defined(_GxGDEW042T2_H_) || defined(_GxGDEW027C44_H_)
+GxIO_Class io(GxIO_Sim::UC8151, GxEPD_WIDTH, GxEPD_HEIGHT);
+#else
+GxIO_Class io(GxIO_Sim::SSD1607, GxEPD_WIDTH, GxEPD_HEIGHT);
+#endif
+#endif
+GxEPD_Class display(io);
+
+#if defined(_GxGDEP015OC1_H_) || defined(_GxGDEH029A1_H_) || defined(_GxGDE0213B1_H_) || \
+    defined(_GxGDEW042T2_H_) || defined(_GxGDEW075T8_H_) || \
+    defined(_GxGDE043A2_H) || defined(_GxGDE060BA_H) || defined(_GxGDEW080T5_H)
+#define HAS_UPDATE_WINDOW
+#endif
+#if defined(_GxGDE043A2_H) || defined(_GxGDE060BA_H) || defined(_GxGDEW080T5_H)
+#define HAS_UPDATE_FAST
+#define HAS_BUFFER_SWAP
+#endif
+#if defined(_GxGDEP015OC1_H_) || defined(_GxGDEH029A1_H_)
+#define HAS_DRAW_PAGED
+#endif
+
+// prototypes, for builds without the Arduino IDE
+void runBenchmarks();
+void drawText();
+void drawShapes();
+void startMeasure();
+void reportMeasure(const char name[]);
+uint32_t waitTime();
+void printValue(uint32_t value);
+void printColumn(const char text[], uint8_t width);
+
+uint32_t start_cpu, start_wait, start_wire, start_busy, start_calls, start_cs, start_cmds, start_data;
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println("GxEPD_SimBenchmark");
+#if defined(PARALLEL_DISPLAY)
+  io.setRowOutput(&row_sim);
+  display.init();
+#if defined(HAS_ROW_PIPELINE)
+  Serial.println("operation        cpu      wait     rows     output   stall    idle     errors");
+#else
+  Serial.println("operation        cpu      wait     rows     output   idle");
+#endif
+#else
+  display.init();
+  io.setRecording(false); // less simulation overhead in cpu time
+  Serial.println("operation        cpu      wait     calls    cs       cmds     data     wire     busy");
+#endif
+  runBenchmarks();
+  Serial.println("done");
+}
+
+void loop()
+{
+}
+
+void runBenchmarks()
+{
+  startMeasure();
+  display.fillScreen(GxEPD_WHITE);
+  reportMeasure("fillScreen");
+
+  startMeasure();
+  for (uint16_t y = 0; y < display.height(); y++)
+  {
+    for (uint16_t x = 0; x < display.width(); x++)
+    {
+      display.drawPixel(x, y, ((x ^ y) & 1) ? GxEPD_BLACK : GxEPD_WHITE);
+    }
+  }
+  reportMeasure("drawPixel");
+
+  startMeasure();
+  display.fillScreen(GxEPD_WHITE);
+  drawText();
+  reportMeasure("text");
+
+  startMeasure();
+  drawShapes();
+  reportMeasure("fillRect/lines");
+
+  startMeasure();
+  display.update();
+  reportMeasure("update");
+
+#if defined(HAS_BUFFER_SWAP)
+  // update() swapped the buffers, draw the same content again
+  display.fillScreen(GxEPD_WHITE);
+  drawText();
+  drawShapes();
+#endif
+  startMeasure();
+  display.update();
+  reportMeasure("update same");
+
+#if defined(HAS_UPDATE_WINDOW)
+  display.fillRect(20, 20, 64, 32, GxEPD_WHITE);
+  startMeasure();
+  display.updateWindow(20, 20, 64, 32);
+  reportMeasure("updateWindow");
+#endif
+
+#if defined(HAS_UPDATE_FAST)
+  display.fillRect(20, display.height() - 52, 64, 32, GxEPD_BLACK);
+  startMeasure();
+  display.updateFast();
+  reportMeasure("updateFast");
+#endif
+
+#if defined(HAS_DRAW_PAGED)
+  startMeasure();
+  display.drawPaged(drawText);
+  reportMeasure("drawPaged");
+#endif
+}
+
+void drawText()
+{
+  display.setTextColor(GxEPD_BLACK);
+  display.setFont(&FreeMonoBold9pt7b);
+  display.setCursor(0, 0);
+  display.println();
+  display.println("Hello World!");
+  display.println("0123456789");
+  display.println("ABCDEFGHIJKLM");
+}
+
+void drawShapes()
+{
+  display.fillRect(10, 10, display.width() - 20, display.height() / 4, GxEPD_BLACK);
+  display.drawFastHLine(0, display.height() / 2, display.width(), GxEPD_BLACK);
+  display.drawFastVLine(display.width() / 2, 0, display.height(), GxEPD_BLACK);
+}
+
+void startMeasure()
+{
+#if defined(PARALLEL_DISPLAY)
+  row_sim.clear(); // the time before the first row of the operation is not idle time
+#else
+  start_wire = io.micros() - io.busyTime();
+  start_busy = io.busyTime();
+  start_calls = io.calls();
+  start_cs = io.transactions();
+  start_cmds = io.commands();
+  start_data = io.dataBytes();
+#endif
+  start_wait = waitTime();
+  start_cpu = micros();
+}
+
+void reportMeasure(const char name[])
+{
+  uint32_t elapsed = micros() - start_cpu;
+  uint32_t wait = waitTime() - start_wait;
+  printColumn(name, 17);
+  printValue(elapsed - wait);
+  printValue(wait);
+#if defined(PARALLEL_DISPLAY)
+  printValue(row_sim.rows());
+  printValue(row_sim.outputTime());
+#if defined(HAS_ROW_PIPELINE)
+  printValue(row_sim.stallTime());
+#endif
+  printValue(row_sim.idleTime());
+#if defined(HAS_ROW_PIPELINE)
+  printValue(row_sim.errors());
+#endif
+#else
+  printValue(io.calls() - start_calls);
+  printValue(io.transactions() - start_cs);
+  printValue(io.commands() - start_cmds);
+  printValue(io.dataBytes() - start_data);
+  printValue(io.micros() - io.busyTime() - start_wire);
+  printValue(io.busyTime() - start_busy);
+#endif
+  Serial.println();
+}
+
+// emulated delays included in micros() on a host, delays are real time on a target
+uint32_t waitTime()
+{
+#if defined(GxEPD_HOST)
+  return delayMicros();
+#else
+  return 0;
+#endif
+}
+
+void printValue(uint32_t value)
+{
+  uint8_t digits = 1;
+  for (uint32_t v = value; v >= 10; v /= 10) digits++;
+  Serial.print(value);
+  for (uint8_t i = digits; i < 9; i++) Serial.print(" ");
+}
+
+void printColumn(const char text[], uint8_t width)
+{
+  Serial.print(text);
+  for (uint8_t i = strlen(text); i < width; i++) Serial.print(" ");
+}
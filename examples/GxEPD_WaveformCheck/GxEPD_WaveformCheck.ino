@@ -0,0 +1,204 @@
+// GxEPD_WaveformCheck : validation of a waveform container (GxEPD_Waveform.h) for HD e-Paper displays with parallel interface.
+//
+// validates the container, compares the frame counts and the per grey level drive of each set
+// with the built-in waveform of the selected display class and between the sets,
+// and shows the set selected by setTemperature() over the temperature range.
+//
+// the display is not refreshed, no panel needs to be connected.
+//
+// To be used with "BLACK 407ZE (V3.0)" of "BLACK F407VE/ZE/ZG boards" of package "STM32GENERIC for STM32 boards" for Arduino.
+// https://github.com/danieleff/STM32GENERIC
+
+// include library, include base class, make path known
+#include <GxEPD.h>
+
+// select the display class to use, only one
+//#include "GxGDE043A2/GxGDE043A2.cpp"
+#include "GxGDE060BA/GxGDE060BA.cpp"
+//#include "GxGDEW080T5/GxGDEW080T5.cpp"
+
+#include "GxIO/GxIO_DESTM32L/GxIO_DESTM32L.cpp"
+
+GxIO_DESTM32L io;
+
+GxEPD_Class display(io);
+
+#if defined(_GxGDE043A2_H)
+#define BUILTIN_BEGIN wave_begin_43
+#define BUILTIN_END wave_end_43
+#define BUILTIN_BEGIN_FRAMES GxGDE043A2_FRAME_BEGIN_SIZE
+#define BUILTIN_END_FRAMES GxGDE043A2_FRAME_END_SIZE
+#elif defined(_GxGDE060BA_H)
+#define BUILTIN_BEGIN wave_begin_60
+#define BUILTIN_END wave_end_60
+#define BUILTIN_BEGIN_FRAMES GxGDE060BA_FRAME_BEGIN_SIZE
+#define BUILTIN_END_FRAMES GxGDE060BA_FRAME_END_SIZE
+#elif defined(_GxGDEW080T5_H)
+#define BUILTIN_BEGIN wave_begin_80
+#define BUILTIN_END wave_end_80
+#define BUILTIN_BEGIN_FRAMES GxGDEW080T5_FRAME_BEGIN_SIZE
+#define BUILTIN_END_FRAMES GxGDEW080T5_FRAME_END_SIZE
+#endif
+
+// the container to check, replace with your own; this is the built-in GDE060BA waveform for 0 .. 50 degree Celsius
+const uint8_t waveform_container[] =
+{
+  'G', 'x', 'W', 'F', 1, 1, // header, version 1, 1 set
+  0, 50, 8, 18, // 0 .. 50 degree Celsius, 8 begin frames, 18 end frames
+  0x00, 0xA8, 0x01, 0xA8, 0x05, 0xA8, 0x15, 0xA8, // begin, GC0->GC3 .. GC3->GC3
+  0x15, 0xA9, 0x5A, 0x95, 0x00, 0x15, 0xA9, 0x5A, 0x94, 0x00, // end, GC3->GC0, GC3->GC1
+  0x15, 0xA9, 0x5A, 0x90, 0x00, 0x15, 0xA9, 0x5A, 0x80, 0x00, // end, GC3->GC2, GC3->GC3
+};
+
+GxEPD_Waveforms waveforms;
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println("GxEPD_WaveformCheck");
+  if (!waveforms.load(waveform_container, sizeof(waveform_container)))
+  {
+    Serial.println("invalid container");
+    return;
+  }
+  Serial.print(waveforms.sets());
+  Serial.println(" sets");
+  printBuiltin();
+  for (uint8_t set = 0; set < waveforms.sets(); set++)
+  {
+    printSet(set);
+  }
+  printSelection();
+  Serial.println("done");
+}
+
+void loop()
+{
+}
+
+// drive counts per grey level: frames to black, frames to white
+void printDrive(const char name[], uint8_t level, uint8_t frames, int16_t set, bool end)
+{
+  uint8_t black = 0, white = 0;
+  for (uint16_t frame = 0; frame < frames; frame++)
+  {
+    uint8_t drive = driveOf(set, end, level, frame);
+    if (drive == 1) black++;
+    if (drive == 2) white++;
+  }
+  Serial.print("  ");
+  Serial.print(name);
+  Serial.print(" GC");
+  Serial.print(level);
+  Serial.print(" : to black ");
+  Serial.print(black);
+  Serial.print(", to white ");
+  Serial.println(white);
+}
+
+// drive of set, -1 for the built-in waveform
+uint8_t driveOf(int16_t set, bool end, uint8_t level, uint16_t frame)
+{
+  if (set >= 0) return waveforms.drive(set, end, level, frame);
+  return end ? BUILTIN_END[level][frame] : BUILTIN_BEGIN[level][frame];
+}
+
+uint8_t framesOf(int16_t set, bool end)
+{
+  if (set >= 0) return end ? waveforms.endFrames(set) : waveforms.beginFrames(set);
+  return end ? BUILTIN_END_FRAMES : BUILTIN_BEGIN_FRAMES;
+}
+
+void printFrames(int16_t set)
+{
+  Serial.print("  frames : begin ");
+  Serial.print(framesOf(set, false));
+  Serial.print(", end ");
+  Serial.print(framesOf(set, true));
+  Serial.print(", total ");
+  Serial.println(framesOf(set, false) + framesOf(set, true));
+  for (uint8_t level = 0; level < 4; level++) printDrive("begin", level, framesOf(set, false), set, false);
+  for (uint8_t level = 0; level < 4; level++) printDrive("end  ", level, framesOf(set, true), set, true);
+}
+
+void printBuiltin()
+{
+  Serial.println("built-in waveform");
+  printFrames(-1);
+}
+
+void printSet(uint8_t set)
+{
+  Serial.print("set ");
+  Serial.print(set);
+  Serial.print(" : ");
+  Serial.print(waveforms.minTemperature(set));
+  Serial.print(" .. ");
+  Serial.print(waveforms.maxTemperature(set));
+  Serial.println(" C");
+  printFrames(set);
+  printDifferences(set, -1, "built-in");
+  if (set > 0) printDifferences(set, set - 1, "previous set");
+  Serial.print("  wave table RAM : ");
+  Serial.println(tableSize(set));
+}
+
+// bytes allocated by setTemperature() for the tables of set, the built-in waveform's tables are in flash
+uint32_t tableSize(uint8_t set)
+{
+  uint32_t frames = waveforms.beginFrames(set) + waveforms.endFrames(set);
+  uint32_t transition_frames = frames - 4; // without the idle frames
+  return frames * 256 + transition_frames * (256 + 2);
+}
+
+// frame count difference and number of frames with different drive, per phase
+void printDifferences(int16_t set, int16_t other, const char name[])
+{
+  Serial.print("  to ");
+  Serial.print(name);
+  Serial.print(" :");
+  for (uint8_t phase = 0; phase < 2; phase++)
+  {
+    bool end = phase;
+    uint8_t frames = framesOf(set, end);
+    uint8_t other_frames = framesOf(other, end);
+    uint16_t differ = 0;
+    for (uint16_t frame = 0; frame < max(frames, other_frames); frame++)
+    {
+      for (uint8_t level = 0; level < 4; level++)
+      {
+        uint8_t a = (frame < frames) ? driveOf(set, end, level, frame) : 0;
+        uint8_t b = (frame < other_frames) ? driveOf(other, end, level, frame) : 0;
+        if (a != b)
+        {
+          differ++;
+          break;
+        }
+      }
+    }
+    Serial.print(end ? ", end " : " begin ");
+    Serial.print(int16_t(frames) - int16_t(other_frames));
+    Serial.print(" frames, ");
+    Serial.print(differ);
+    Serial.print(" frames differ");
+  }
+  Serial.println();
+}
+
+void printSelection()
+{
+  display.setWaveforms(&waveforms);
+  for (int8_t temperature = -10; temperature <= 60; temperature += 10)
+  {
+    bool loaded = display.setTemperature(temperature);
+    Serial.print(temperature);
+    Serial.print(" C : ");
+    if (loaded)
+    {
+      Serial.print("set ");
+      Serial.println(waveforms.find(temperature));
+    }
+    else Serial.println("built-in");
+  }
+}
@@ -0,0 +1,8 @@
+// Adafruit_I2CDevice.h : placeholder for host builds, included by Adafruit_GFX.h of Adafruit_GFX 1.10 and later
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Host_Adafruit_I2CDevice_H_
+#define _GxEPD_Host_Adafruit_I2CDevice_H_
+
+#endif
@@ -0,0 +1,89 @@
+// Arduino.cpp : Arduino API emulation for host builds, time, pins, Serial and main()
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "Arduino.h"
+#include "SPI.h"
+#include <time.h>
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+GPIO_TypeDef GPIO_host[7];
+RCC_TypeDef RCC_host;
+FSMC_Bank1_TypeDef FSMC_Bank1_host;
+FSMC_Bank1E_TypeDef FSMC_Bank1E_host;
+
+static uint8_t pin_levels[256];
+static uint64_t delay_us; // time of delay() and delayMicroseconds(), added to the host time
+
+static uint64_t host_us()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000 + uint64_t(ts.tv_nsec) / 1000;
+}
+
+static uint64_t start_us = host_us();
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  pin_levels[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin)
+{
+  return pin_levels[pin];
+}
+
+void delay(unsigned long ms)
+{
+  delay_us += uint64_t(ms) * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  delay_us += us;
+}
+
+unsigned long micros(void)
+{
+  return (unsigned long)(uint32_t)(host_us() - start_us + delay_us);
+}
+
+unsigned long millis(void)
+{
+  return (unsigned long)(uint32_t)((host_us() - start_us + delay_us) / 1000);
+}
+
+void yield(void)
+{
+}
+
+unsigned long delayMicros(void)
+{
+  return (unsigned long)(uint32_t)delay_us;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if (c == '\r') return 1; // text lines of stdout end with \n
+  return putchar(c) == EOF ? 0 : 1;
+}
+
+int HardwareSerial::read(void)
+{
+  return getchar();
+}
+
+int main()
+{
+  setup();
+  loop();
+  fflush(stdout);
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Arduino.h : Arduino API emulation for host builds of the examples that run without a display
+//
+// the subset of the Arduino API used by this library, its examples and Adafruit_GFX, for a Linux or macOS host.
+// micros() and millis() are the real time of the host plus the time of delay() and delayMicroseconds(),
+// these return immediately; digitalRead() returns the level last written by digitalWrite().
+// the sketch is run by main() of Arduino.cpp : setup(), then loop() once.
+// stm32_host.h adds the registers and pins of the STM32 boards used by the parallel display classes.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Host_Arduino_H_
+#define _GxEPD_Host_Arduino_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+#define GxEPD_HOST 1
+
+#if !defined(ARDUINO)
+#define ARDUINO 10805 // for libraries that check the Arduino version, e.g. Adafruit_GFX
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// no separate program memory on a host; pgm_read_dword() is 32 bit as on the targets,
+// pgm_read_pointer() is as wide as a pointer, Adafruit_GFX reads font pointers with it
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_pointer(addr) (*(void* const*)(addr))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+#ifndef min
+#define min(a,b) ((a)<(b)?(a):(b))
+#endif
+#ifndef max
+#define max(a,b) ((a)>(b)?(a):(b))
+#endif
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long micros(void);
+unsigned long millis(void);
+void yield(void);
+// host only : the time of delay() and delayMicroseconds() included in micros(), in us
+unsigned long delayMicros(void);
+
+void setup(void);
+void loop(void);
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "stm32_host.h"
+
+class HardwareSerial : public Stream
+{
+  public:
+    void begin(unsigned long baud) {(void)baud;};
+    size_t write(uint8_t c);
+    using Print::write;
+    int read(void);
+    operator bool() {return true;};
+};
+
+extern HardwareSerial Serial; // stdout and stdin
+
+#endif
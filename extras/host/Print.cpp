@@ -0,0 +1,169 @@
+// Print.cpp : Print class of the Arduino API emulation for host builds
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "Arduino.h"
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+  size_t n = 0;
+  while (size--)
+  {
+    if (write(*buffer++)) n++;
+    else break;
+  }
+  return n;
+}
+
+size_t Print::write(const char* str)
+{
+  if (!str) return 0;
+  return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::print(const __FlashStringHelper* str)
+{
+  return write(reinterpret_cast<const char*>(str));
+}
+
+size_t Print::print(const String& str)
+{
+  return write((const uint8_t*)str.c_str(), str.length());
+}
+
+size_t Print::print(const char str[])
+{
+  return write(str);
+}
+
+size_t Print::print(char c)
+{
+  return write(uint8_t(c));
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+  return print((unsigned long) value, base);
+}
+
+size_t Print::print(int value, int base)
+{
+  return print((long) value, base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+  return print((unsigned long) value, base);
+}
+
+size_t Print::print(long value, int base)
+{
+  if (base == 0) return write(uint8_t(value));
+  if ((base == 10) && (value < 0))
+  {
+    size_t n = print('-');
+    return n + _printNumber(0ul - (unsigned long)value, 10);
+  }
+  return _printNumber((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+  if (base == 0) return write(uint8_t(value));
+  return _printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+  return _printFloat(value, digits);
+}
+
+size_t Print::println(void)
+{
+  return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper* str)
+{
+  size_t n = print(str);
+  return n + println();
+}
+
+size_t Print::println(const String& str)
+{
+  size_t n = print(str);
+  return n + println();
+}
+
+size_t Print::println(const char str[])
+{
+  size_t n = print(str);
+  return n + println();
+}
+
+size_t Print::println(char c)
+{
+  size_t n = print(c);
+  return n + println();
+}
+
+size_t Print::println(unsigned char value, int base)
+{
+  size_t n = print(value, base);
+  return n + println();
+}
+
+size_t Print::println(int value, int base)
+{
+  size_t n = print(value, base);
+  return n + println();
+}
+
+size_t Print::println(unsigned int value, int base)
+{
+  size_t n = print(value, base);
+  return n + println();
+}
+
+size_t Print::println(long value, int base)
+{
+  size_t n = print(value, base);
+  return n + println();
+}
+
+size_t Print::println(unsigned long value, int base)
+{
+  size_t n = print(value, base);
+  return n + println();
+}
+
+size_t Print::println(double value, int digits)
+{
+  size_t n = print(value, digits);
+  return n + println();
+}
+
+size_t Print::_printNumber(unsigned long value, uint8_t base)
+{
+  char buf[8 * sizeof(unsigned long) + 1];
+  char* p = &buf[sizeof(buf) - 1];
+  *p = 0;
+  if (base < 2) base = 10;
+  do
+  {
+    char digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    value /= base;
+  }
+  while (value);
+  return write(p);
+}
+
+size_t Print::_printFloat(double value, uint8_t digits)
+{
+  char buf[64];
+  if (isnan(value)) return write("nan");
+  if (isinf(value)) return write("inf");
+  snprintf(buf, sizeof(buf), "%.*f", digits, value);
+  return write(buf);
+}
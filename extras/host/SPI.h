@@ -0,0 +1,56 @@
+// SPI.h : SPI class of the Arduino API emulation for host builds, no device attached
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Host_SPI_H_
+#define _GxEPD_Host_SPI_H_
+
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION 1
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+#define SPI_CLOCK_DIV2 2
+#define SPI_CLOCK_DIV4 4
+#define SPI_CLOCK_DIV8 8
+#define SPI_CLOCK_DIV16 16
+#define SPI_CLOCK_DIV32 32
+#define SPI_CLOCK_DIV64 64
+#define SPI_CLOCK_DIV128 128
+
+#define SS 10
+
+class SPISettings
+{
+  public:
+    SPISettings() {};
+    SPISettings(uint32_t, uint8_t, uint8_t) {};
+};
+
+// transfers return 0xFF, the level of an idle MISO line
+class SPIClass
+{
+  public:
+    void begin() {};
+    void end() {};
+    void beginTransaction(SPISettings) {};
+    void endTransaction() {};
+    void setBitOrder(uint8_t) {};
+    void setDataMode(uint8_t) {};
+    void setClockDivider(uint32_t) {};
+    void setFrequency(uint32_t) {};
+    uint8_t transfer(uint8_t) {return 0xFF;};
+    uint16_t transfer16(uint16_t) {return 0xFFFF;};
+    void transfer(void* buf, size_t count) {memset(buf, 0xFF, count);};
+};
+
+extern SPIClass SPI;
+
+#endif
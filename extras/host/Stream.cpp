@@ -0,0 +1,17 @@
+// Stream.cpp : Stream class of the Arduino API emulation for host builds
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "Arduino.h"
+
+size_t Stream::readBytes(char* buffer, size_t size)
+{
+  size_t n = 0;
+  while (n < size)
+  {
+    int c = read();
+    if (c < 0) break;
+    buffer[n++] = char(c);
+  }
+  return n;
+}
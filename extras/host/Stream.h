@@ -0,0 +1,20 @@
+// Stream.h : Stream class of the Arduino API emulation for host builds, without timeout
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Host_Stream_H_
+#define _GxEPD_Host_Stream_H_
+
+#include "Print.h"
+
+class Stream : public Print
+{
+  public:
+    virtual int available(void) {return 0;};
+    virtual int read(void) = 0;
+    // reads until size bytes or end of input, returns the bytes read
+    size_t readBytes(char* buffer, size_t size);
+    size_t readBytes(uint8_t* buffer, size_t size) {return readBytes((char*)buffer, size);};
+};
+
+#endif
@@ -0,0 +1,174 @@
+// WString.cpp : String class of the Arduino API emulation for host builds
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#include "Arduino.h"
+
+String::String(const char* cstr) : _buffer(0), _length(0)
+{
+  _assign(cstr ? cstr : "", cstr ? strlen(cstr) : 0);
+}
+
+String::String(const String& str) : _buffer(0), _length(0)
+{
+  _assign(str._buffer, str._length);
+}
+
+String::String(const __FlashStringHelper* str) : _buffer(0), _length(0)
+{
+  const char* cstr = reinterpret_cast<const char*>(str);
+  _assign(cstr ? cstr : "", cstr ? strlen(cstr) : 0);
+}
+
+String::String(char c) : _buffer(0), _length(0)
+{
+  _assign(&c, 1);
+}
+
+String::String(unsigned char value, unsigned char base) : _buffer(0), _length(0)
+{
+  _number(value, base, false);
+}
+
+String::String(int value, unsigned char base) : _buffer(0), _length(0)
+{
+  if ((base == 10) && (value < 0)) _number(-(long)value, base, true);
+  else _number((unsigned int)value, base, false);
+}
+
+String::String(unsigned int value, unsigned char base) : _buffer(0), _length(0)
+{
+  _number(value, base, false);
+}
+
+String::String(long value, unsigned char base) : _buffer(0), _length(0)
+{
+  if ((base == 10) && (value < 0)) _number(0ul - (unsigned long)value, base, true);
+  else _number((unsigned long)value, base, false);
+}
+
+String::String(unsigned long value, unsigned char base) : _buffer(0), _length(0)
+{
+  _number(value, base, false);
+}
+
+String::String(double value, unsigned char decimal_places) : _buffer(0), _length(0)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimal_places, value);
+  _assign(buf, strlen(buf));
+}
+
+String::~String()
+{
+  free(_buffer);
+}
+
+String& String::operator=(const String& rhs)
+{
+  if (this != &rhs) _assign(rhs._buffer, rhs._length);
+  return *this;
+}
+
+String& String::operator=(const char* cstr)
+{
+  _assign(cstr ? cstr : "", cstr ? strlen(cstr) : 0);
+  return *this;
+}
+
+String& String::operator+=(const String& rhs)
+{
+  _append(rhs._buffer, rhs._length);
+  return *this;
+}
+
+String& String::operator+=(const char* cstr)
+{
+  if (cstr) _append(cstr, strlen(cstr));
+  return *this;
+}
+
+String& String::operator+=(char c)
+{
+  _append(&c, 1);
+  return *this;
+}
+
+String operator+(const String& lhs, const String& rhs)
+{
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const String& lhs, const char* rhs)
+{
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const char* lhs, const String& rhs)
+{
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+bool String::operator==(const String& rhs) const
+{
+  return (_length == rhs._length) && (memcmp(_buffer, rhs._buffer, _length) == 0);
+}
+
+bool String::operator==(const char* cstr) const
+{
+  return strcmp(_buffer, cstr ? cstr : "") == 0;
+}
+
+char String::operator[](unsigned int index) const
+{
+  return index < _length ? _buffer[index] : 0;
+}
+
+int String::toInt(void) const
+{
+  return atoi(_buffer);
+}
+
+void String::_assign(const char* cstr, unsigned int length)
+{
+  char* buffer = (char*) malloc(length + 1);
+  if (!buffer) abort();
+  memcpy(buffer, cstr, length);
+  buffer[length] = 0;
+  free(_buffer);
+  _buffer = buffer;
+  _length = length;
+}
+
+void String::_append(const char* cstr, unsigned int length)
+{
+  char* buffer = (char*) realloc(_buffer, _length + length + 1);
+  if (!buffer) abort();
+  memmove(buffer + _length, cstr, length);
+  _buffer = buffer;
+  _length += length;
+  _buffer[_length] = 0;
+}
+
+void String::_number(unsigned long value, unsigned char base, bool negative)
+{
+  char buf[8 * sizeof(unsigned long) + 2];
+  char* p = &buf[sizeof(buf) - 1];
+  *p = 0;
+  if (base < 2) base = 10;
+  do
+  {
+    unsigned char digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    value /= base;
+  }
+  while (value);
+  if (negative) *--p = '-';
+  _assign(p, strlen(p));
+}
@@ -0,0 +1,52 @@
+// WString.h : String class of the Arduino API emulation for host builds, the commonly used subset
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Host_WString_H_
+#define _GxEPD_Host_WString_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+class __FlashStringHelper;
+
+class String
+{
+  public:
+    String(const char* cstr = "");
+    String(const String& str);
+    String(const __FlashStringHelper* str);
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(double value, unsigned char decimal_places = 2);
+    ~String();
+    String& operator=(const String& rhs);
+    String& operator=(const char* cstr);
+    String& operator+=(const String& rhs);
+    String& operator+=(const char* cstr);
+    String& operator+=(char c);
+    friend String operator+(const String& lhs, const String& rhs);
+    friend String operator+(const String& lhs, const char* rhs);
+    friend String operator+(const char* lhs, const String& rhs);
+    bool operator==(const String& rhs) const;
+    bool operator==(const char* cstr) const;
+    bool operator!=(const String& rhs) const {return !(*this == rhs);};
+    bool operator!=(const char* cstr) const {return !(*this == cstr);};
+    char operator[](unsigned int index) const;
+    unsigned int length(void) const {return _length;};
+    const char* c_str() const {return _buffer;};
+    int toInt(void) const;
+  private:
+    void _assign(const char* cstr, unsigned int length);
+    void _append(const char* cstr, unsigned int length);
+    void _number(unsigned long value, unsigned char base, bool negative);
+  private:
+    char* _buffer;
+    unsigned int _length;
+};
+
+#endif
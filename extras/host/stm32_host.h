@@ -0,0 +1,73 @@
+// stm32_host.h : registers and pins of the STM32 boards of the parallel display classes, for host builds
+//
+// register writes have no effect; the row output of the parallel display classes is simulated by a row output backend,
+// GxIO_DESTM32L_RowSim or GxIO_GreenSTM32F103V_RowSim. one GPIO register block with the fields of the STM32F1 and STM32F4 series.
+//
+// License: GNU GENERAL PUBLIC LICENSE V3, see LICENSE
+
+#ifndef _GxEPD_Host_stm32_host_H_
+#define _GxEPD_Host_stm32_host_H_
+
+#include <stdint.h>
+
+#define __IO volatile
+
+typedef struct
+{
+  __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2]; // STM32F4
+  __IO uint32_t CRL, CRH, BRR; // STM32F1
+} GPIO_TypeDef;
+
+typedef struct
+{
+  __IO uint32_t AHB1ENR, AHB3ENR;
+} RCC_TypeDef;
+
+typedef struct
+{
+  __IO uint32_t BTCR[8];
+} FSMC_Bank1_TypeDef;
+
+typedef struct
+{
+  __IO uint32_t BWTR[7];
+} FSMC_Bank1E_TypeDef;
+
+extern GPIO_TypeDef GPIO_host[7];
+extern RCC_TypeDef RCC_host;
+extern FSMC_Bank1_TypeDef FSMC_Bank1_host;
+extern FSMC_Bank1E_TypeDef FSMC_Bank1E_host;
+
+// GxIO_GreenSTM32F103V defines GPIOA .. GPIOC as GPIOA_BASE .. GPIOC_BASE, as for the STM32F1 package of its board
+#define GPIOA_BASE (&GPIO_host[0])
+#define GPIOB_BASE (&GPIO_host[1])
+#define GPIOC_BASE (&GPIO_host[2])
+#define GPIOA GPIOA_BASE
+#define GPIOB GPIOB_BASE
+#define GPIOC GPIOC_BASE
+#define GPIOD (&GPIO_host[3])
+#define GPIOE (&GPIO_host[4])
+#define GPIOF (&GPIO_host[5])
+#define GPIOG (&GPIO_host[6])
+
+#define RCC (&RCC_host)
+#define RCC_AHB1ENR_GPIODEN (0x1 << 3)
+#define RCC_AHB3ENR_FSMCEN (0x1 << 0)
+#define READ_BIT(REG, BIT) ((REG) & (BIT))
+
+#define FSMC_Bank1 (&FSMC_Bank1_host)
+#define FSMC_Bank1E (&FSMC_Bank1E_host)
+
+// pin numbers for pinMode() and digitalWrite(), 16 per port
+enum
+{
+  PA0 = 0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
+  PB0 = 16, PB1, PB2, PB3, PB4, PB5, PB6, PB7, PB8, PB9, PB10, PB11, PB12, PB13, PB14, PB15,
+  PC0 = 32, PC1, PC2, PC3, PC4, PC5, PC6, PC7, PC8, PC9, PC10, PC11, PC12, PC13, PC14, PC15,
+  PD0 = 48, PD1, PD2, PD3, PD4, PD5, PD6, PD7, PD8, PD9, PD10, PD11, PD12, PD13, PD14, PD15,
+  PE0 = 64, PE1, PE2, PE3, PE4, PE5, PE6, PE7, PE8, PE9, PE10, PE11, PE12, PE13, PE14, PE15,
+  PF0 = 80, PF1, PF2, PF3, PF4, PF5, PF6, PF7, PF8, PF9, PF10, PF11, PF12, PF13, PF14, PF15,
+  PG0 = 96, PG1, PG2, PG3, PG4, PG5, PG6, PG7, PG8, PG9, PG10, PG11, PG12, PG13, PG14, PG15
+};
+
+#endif